@@ -1,25 +1,43 @@
 #include "BarcodeWidget.h"
 #include "about_dialog.h"
+#include "batch/ArchiveReader.h"
+#include "batch/ArchiveWriter.h"
+#include "batch/BatchJournal.h"
+#include "components/ResultItemDelegate.h"
+#include "components/ResultListModel.h"
+#include "components/ThumbnailService.h"
 #include "components/UiConfig.h"
 #include "components/message_dialog.h"
 #include "convert.h"
 #include "version_info/version.h"
+#include <QActionGroup>
+#include <QBuffer>
 #include <QCheckBox>
 #include <QComboBox>
+#include <QDialog>
+#include <QDialogButtonBox>
 #include <QFileDialog>
 #include <QFont>
+#include <QFontDatabase>
 #include <QFutureWatcher>
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QLineEdit>
+#include <QListView>
+#include <QLocale>
 #include <QMenu>
 #include <QMenuBar>
 #include <QMessageBox>
 #include <QPainter>
 #include <QPixmap>
+#include <QPlainTextEdit>
 #include <QProgressBar>
 #include <QPushButton>
 #include <QScrollArea>
+#include <QScrollBar>
+#include <QStackedWidget>
+#include <QTimer>
+#include <QVBoxLayout>
 #include <QtConcurrent>
 #include <SimpleBase64.h>
 #include <ZXing/BarcodeFormat.h>
@@ -112,6 +130,9 @@ static QRegularExpression fileExtensionRegex_text(R"(^.*\.(?:txt|json|rfa)$)",
 static QRegularExpression fileExtensionRegex_image(R"(^.*\.(?:png|jpg|jpeg|bmp|gif|tiff|webp)$)",
                                                    QRegularExpression::CaseInsensitiveOption);
 
+static QRegularExpression fileExtensionRegex_archive(R"(^.*\.(?:zip|tar)$)",
+                                                     QRegularExpression::CaseInsensitiveOption);
+
 BarcodeWidget::BarcodeWidget(QWidget *parent)
     : QWidget(parent) {
     setWindowTitle("Lab2QRCode");
@@ -136,11 +157,34 @@ BarcodeWidget::BarcodeWidget(QWidget *parent)
     directTextAction->setCheckable(true);
     directTextAction->setChecked(false); // 默认不勾选
 
+    // 批处理断点续传，默认勾选
+    resumeAction = new QAction("断点续传", this);
+    resumeAction->setCheckable(true);
+    resumeAction->setChecked(true);
+
     helpMenu->addAction(aboutAction);
     toolsMenu->addAction(debugMqttAction);
     toolsMenu->addAction(openCameraScanAction);
     settingMenu->addAction(base64CheckAcion);
     settingMenu->addAction(directTextAction);
+    settingMenu->addAction(resumeAction);
+
+    // 多个结果的保存方式：逐个保存文件，或顺序写入单个压缩包
+    saveModeMenu = settingMenu->addMenu("批量保存方式");
+    saveModeGroup = new QActionGroup(this);
+    const std::pair<const char *, int> saveModes[] = {
+        {"逐个保存文件", -1},
+        {"ZIP（仅存储）", static_cast<int>(ArchiveWriter::Format::ZipStore)},
+        {"ZIP（快速压缩）", static_cast<int>(ArchiveWriter::Format::ZipDeflate)},
+        {"TAR", static_cast<int>(ArchiveWriter::Format::Tar)},
+    };
+    for (const auto &[text, mode] : saveModes) {
+        QAction *action = saveModeMenu->addAction(text);
+        action->setCheckable(true);
+        action->setData(mode);
+        action->setChecked(mode < 0); // 默认逐个保存
+        saveModeGroup->addAction(action);
+    }
 
     // 连接菜单项的点击信号
     connect(aboutAction, &QAction::triggered, this, &BarcodeWidget::showAbout);
@@ -209,12 +253,60 @@ BarcodeWidget::BarcodeWidget(QWidget *parent)
         "QProgressBar::chunk { background-color: #4CAF50; width: 1px; }");
     mainLayout->addWidget(progressBar);
 
+    summaryLabel = new QLabel(this);
+    summaryLabel->setFont(Ui::getAppFont(11));
+    summaryLabel->setStyleSheet("QLabel { color: #666; }");
+    summaryLabel->setWordWrap(true);
+    summaryLabel->setVisible(false);
+    connect(summaryLabel, &QLabel::linkActivated, this, &BarcodeWidget::showBatchReport);
+    mainLayout->addWidget(summaryLabel);
+
     // 图片展示区域
     scrollArea = new QScrollArea(this);
     scrollArea->setWidgetResizable(true);
-    scrollArea->setMinimumHeight(320);
     scrollArea->setStyleSheet("QScrollArea { background-color: #f0f0f0; border: 1px solid #ccc; }");
-    mainLayout->addWidget(scrollArea);
+
+    // 多结果网格：模型/视图实现，只绘制可见项，缩略图由后台线程生成
+    resultModel = new ResultListModel(lastResults, this);
+    resultView = new QListView(this);
+    resultView->setViewMode(QListView::IconMode);
+    resultView->setResizeMode(QListView::Adjust);
+    resultView->setMovement(QListView::Static);
+    resultView->setLayoutMode(QListView::Batched);
+    resultView->setUniformItemSizes(true);
+    resultView->setSpacing(10);
+    resultView->setSelectionMode(QAbstractItemView::NoSelection);
+    resultView->setMouseTracking(true); // 悬停高亮
+    resultView->setItemDelegate(new ResultItemDelegate(resultView));
+    resultView->setModel(resultModel);
+    resultView->setStyleSheet("QListView { background-color: #f0f0f0; border: 1px solid #ccc; }");
+    // 滚动后撤销已滚出可见区域的项尚未开始的缩略图任务，快速翻过大量结果时只为停下来的那一屏生成缩略图
+    connect(resultView->verticalScrollBar(), &QScrollBar::valueChanged, this, [this] {
+        // 静态网格中各项的位置随序号单调递增，二分查找第一个满足条件的项
+        const int height = resultView->viewport()->height();
+        const auto firstRowWhere = [this](auto &&pred) {
+            int lo = 0;
+            int hi = resultModel->rowCount();
+            while (lo < hi) {
+                const int mid = lo + (hi - lo) / 2;
+                if (pred(resultView->visualRect(resultModel->index(mid)))) {
+                    hi = mid;
+                } else {
+                    lo = mid + 1;
+                }
+            }
+            return lo;
+        };
+        const int first = firstRowWhere([](const QRect &rect) { return rect.bottom() >= 0; });
+        const int last = firstRowWhere([height](const QRect &rect) { return rect.top() > height; }) - 1;
+        resultModel->setVisibleRows(first, last);
+    });
+
+    resultStack = new QStackedWidget(this);
+    resultStack->setMinimumHeight(320);
+    resultStack->addWidget(scrollArea);
+    resultStack->addWidget(resultView);
+    mainLayout->addWidget(resultStack);
 
     auto *comboBoxLayout = new QHBoxLayout();
 
@@ -255,9 +347,15 @@ BarcodeWidget::BarcodeWidget(QWidget *parent)
 
     mainLayout->addLayout(sizeLayout);
 
-    fileDialog = new QFileDialog(this, "Select File", "", "Supported Files (*.rfa *.txt *.png);;All Files (*)");
+    fileDialog = new QFileDialog(
+        this, "Select File", "", "Supported Files (*.rfa *.txt *.png *.zip *.tar);;All Files (*)");
     fileDialog->setModal(false);
 
+    // 批处理结果每 50ms 合并刷新一次，避免每个结果单独触发一次界面更新
+    resultFlushTimer = new QTimer(this);
+    resultFlushTimer->setInterval(50);
+    connect(resultFlushTimer, &QTimer::timeout, this, &BarcodeWidget::flushPendingResults);
+
     MqttConfig config = MqttSubscriber::loadMqttConfig("./setting/config.json");
 
     subscriber_ = std::make_unique<MqttSubscriber>(
@@ -273,7 +371,9 @@ BarcodeWidget::BarcodeWidget(QWidget *parent)
     connect(decodeToChemFile, &QPushButton::clicked, this, &BarcodeWidget::onDecodeToChemFileClicked);
     connect(saveButton, &QPushButton::clicked, this, &BarcodeWidget::onSaveClicked);
     connect(filePathEdit, &QLineEdit::textChanged, this, [this](const QString &text) {
-        lastResults.clear();
+        discardJournal();
+        replaceResults({});
+        summaryLabel->setVisible(false);
         lastSelectedFiles = text.split(QDir::listSeparator());
         if (lastSelectedFiles.size() == 1) {
             if (lastSelectedFiles.front().isEmpty()) {
@@ -324,7 +424,8 @@ BarcodeWidget::BarcodeWidget(QWidget *parent)
     connect(directTextAction, &QAction::toggled, this, [this, browseButton](bool checked) {
         filePathEdit->clear();
         lastSelectedFiles.clear();
-        lastResults.clear();
+        discardJournal();
+        replaceResults({});
 
         if (checked) {
             filePathEdit->setPlaceholderText("输入要转换的文字");
@@ -343,7 +444,8 @@ BarcodeWidget::BarcodeWidget(QWidget *parent)
         filePathEdit->clear();
         filePathEdit->setText(filenames.join(QDir::listSeparator()));
         lastSelectedFiles = filenames;
-        lastResults.clear();
+        discardJournal();
+        replaceResults({});
         renderResults();
         updateButtonStates();
     });
@@ -362,8 +464,9 @@ void BarcodeWidget::updateButtonStates() const {
             auto &file = lastSelectedFiles.front();
 
             bool isImage = fileExtensionRegex_image.match(file).hasMatch();
+            bool isArchive = fileExtensionRegex_archive.match(file).hasMatch();
             generateButton->setEnabled(!isImage);
-            decodeToChemFile->setEnabled(isImage);
+            decodeToChemFile->setEnabled(isImage || isArchive);
         } else {
             generateButton->setEnabled(true);
             decodeToChemFile->setEnabled(true);
@@ -409,8 +512,10 @@ void BarcodeWidget::onGenerateClicked() {
 
             bool useBase64;
             convert::QRcode_create_config config;
+            std::shared_ptr<BatchProfiler> profiler;
 
             convert::result_data_entry operator()(const QString &textInput) const {
+                BatchProfiler::Item timing(profiler.get(), "raw_text_input");
                 convert::result_data_entry res;
                 // 对于直接文本模式，source_file_name 可以设为空，或者设为一个标识字符串
                 // 这样在保存文件时，会默认生成 "qrcode.png" 之类的名字
@@ -420,6 +525,7 @@ void BarcodeWidget::onGenerateClicked() {
                     std::string content;
                     if (useBase64) {
                         // 如果勾选了 Base64，先将输入文本转为 UTF-8 字节流，再 Base64 编码
+                        BatchProfiler::Stage stage(BatchStage::Base64);
                         QByteArray data = textInput.toUtf8();
                         content =
                             SimpleBase64::encode(reinterpret_cast<const std::uint8_t *>(data.constData()), data.size());
@@ -427,7 +533,10 @@ void BarcodeWidget::onGenerateClicked() {
                         content = textInput.toStdString();
                     }
 
-                    auto img = convert::byte_to_QRCode_qimage(content, config);
+                    const auto bitMatrix = BatchProfiler::measure(
+                        BatchStage::Encode, [&] { return convert::byte_to_BitMatrix(content, config); });
+                    auto img = BatchProfiler::measure(BatchStage::Raster,
+                                                      [&] { return convert::BitMatrix_to_qimage(bitMatrix); });
 
                     if (!img.isNull()) {
                         res.data = img;
@@ -439,16 +548,14 @@ void BarcodeWidget::onGenerateClicked() {
             }
         };
 
-        auto *watcher = new QFutureWatcher<convert::result_data_entry>(this);
-        connect(watcher, &QFutureWatcher<convert::result_data_entry>::finished, [this, watcher] {
-            onBatchFinish(*watcher);
-        });
+        // 直接文本输入无需断点续传
+        discardJournal();
 
         // 启动异步任务
-        watcher->setFuture(QtConcurrent::mapped(inputs,
-                                                TextWorker{
-                                                    useBase64, {reqWidth, reqHeight, format}
-        }));
+        activeProfiler = std::make_shared<BatchProfiler>();
+        startBatch(QtConcurrent::mapped(inputs, TextWorker{useBase64, {reqWidth, reqHeight, format}, activeProfiler}),
+                   {},
+                   BatchPlan::identity(static_cast<int>(inputs.size())));
 
         return; // 结束函数，不再执行下方的文件处理逻辑
     }
@@ -474,40 +581,110 @@ void BarcodeWidget::onGenerateClicked() {
     saveButton->setEnabled(false);
     this->setCursor(Qt::WaitCursor);
 
+    const QString options = QString("%1x%2;%3;base64=%4")
+                                .arg(reqWidth)
+                                .arg(reqHeight)
+                                .arg(barcodeFormatToString(format))
+                                .arg(useBase64);
+    activeJournal = openJournal("generate", options, filePaths);
+    activeProfiler = std::make_shared<BatchProfiler>();
+
     struct worker {
         using result_type = convert::result_data_entry;
         int reqWidth;
         int reqHeight;
         bool useBase64;
         ZXing::BarcodeFormat format;
-
-        convert::result_data_entry operator()(const QString &filePath) const {
+        QStringList filePaths;
+        std::shared_ptr<BatchJournal> journal;
+        std::shared_ptr<BatchProfiler> profiler;
+        std::vector<QByteArray> hashes; /**< 执行计划中算出的内容哈希 */
+
+        convert::result_data_entry operator()(int index) const {
+            const QString &filePath = filePaths[index];
+            BatchProfiler::Item timing(profiler.get(), filePath);
             try {
                 QFile file(filePath);
 
                 convert::result_data_entry res;
                 if (!file.open(QIODevice::ReadOnly)) {
                     res.data = std::string("无法打开文件: ") + filePath.toStdString();
-                    res.source_file_name = std::move(filePath);
+                    res.source_file_name = filePath;
                     return res;
                 } else {
-                    res.source_file_name = std::move(filePath);
+                    res.source_file_name = filePath;
+                }
+
+                // 超出任何字符集下单个条码容量的文件必然无法生成，不必读取
+                const qint64 size = file.size();
+                const std::size_t capacity = convert::max_payload_chars(format);
+                if (const auto payload = convert::encoded_payload_size(static_cast<std::size_t>(size), useBase64);
+                    capacity > 0 && payload > capacity) {
+                    res.data = QString("文件过大：编码后 %1 字符，超出 %2 单个条码的最大容量 %3 字符")
+                                   .arg(payload)
+                                   .arg(barcodeFormatToString(format))
+                                   .arg(capacity)
+                                   .toStdString();
+                    return res;
                 }
 
-                const QByteArray data = file.readAll();
-                file.close();
+                // 映射文件，哈希和编码直接读取映射内存，不再整体复制到 QByteArray；映射在 file 关闭前有效
+                QByteArray buffer;
+                std::string_view data;
+                {
+                    BatchProfiler::Stage stage(BatchStage::Read);
+                    if (const uchar *mapped = size > 0 ? file.map(0, size) : nullptr) {
+                        data = {reinterpret_cast<const char *>(mapped), static_cast<std::size_t>(size)};
+                    } else {
+                        // 无法映射（空文件、部分网络文件系统）时退回整体读取
+                        buffer = file.readAll();
+                        data = {buffer.constData(), static_cast<std::size_t>(buffer.size())};
+                    }
+                }
+
+                // 上次运行已完成且内容未变，直接读取输出目录中的结果；执行计划已算过的哈希直接复用
+                QByteArray contentHash = hashes.empty() ? QByteArray{} : hashes[index];
+                if (journal) {
+                    if (contentHash.isEmpty()) {
+                        contentHash = BatchProfiler::measure(BatchStage::Hash, [&] {
+                            return BatchJournal::hashContent(data.data(), static_cast<qint64>(data.size()));
+                        });
+                    }
+                    if (const auto done = journal->findCompleted(index, contentHash)) {
+                        BatchProfiler::Stage stage(BatchStage::Read);
+                        if (QImage img(done->outputPath); !img.isNull()) {
+                            res.data = std::move(img);
+                            return res;
+                        }
+                    }
+                }
 
                 // 是否base64处理通过判断base64CheckBox
                 std::string text;
                 if (useBase64) {
-                    text = SimpleBase64::encode(reinterpret_cast<const std::uint8_t *>(data.constData()), data.size());
+                    BatchProfiler::Stage stage(BatchStage::Base64);
+                    text = SimpleBase64::encode(reinterpret_cast<const std::uint8_t *>(data.data()), data.size());
                 } else {
-                    text = data.toStdString();
+                    text.assign(data);
                 }
 
-                auto img = convert::byte_to_QRCode_qimage(
-                    text, {.target_width = reqWidth, .target_height = reqHeight, .format = format, .margin = 1});
-
+                const auto bitMatrix = BatchProfiler::measure(BatchStage::Encode, [&] {
+                    return convert::byte_to_BitMatrix(
+                        text, {.target_width = reqWidth, .target_height = reqHeight, .format = format, .margin = 1});
+                });
+                auto img =
+                    BatchProfiler::measure(BatchStage::Raster, [&] { return convert::BitMatrix_to_qimage(bitMatrix); });
+
+                // 先写入输出目录再记录，日志中成功的每一项都有完整的结果文件；保存时直接复制这份 PNG
+                if (journal) {
+                    const QString outputPath = journal->outputPathFor(index, "png");
+                    bool saved = false;
+                    if (!img.isNull()) {
+                        BatchProfiler::Stage stage(BatchStage::Save);
+                        saved = img.save(outputPath, "PNG");
+                    }
+                    journal->append({index, contentHash, saved ? outputPath : QString{}, saved});
+                }
                 if (!img.isNull()) {
                     res.data = img;
                 } else {
@@ -517,29 +694,81 @@ void BarcodeWidget::onGenerateClicked() {
                 return res;
             } catch (const std::exception &e) {
                 convert::result_data_entry res;
-                res.source_file_name = std::move(filePath);
+                res.source_file_name = filePath;
                 res.data.emplace<std::string>(e.what());
                 return res;
             }
         }
     };
 
-    auto *watcher = new QFutureWatcher<convert::result_data_entry>(this);
-
-    connect(watcher,
-            &QFutureWatcher<convert::result_data_entry>::progressValueChanged,
-            progressBar,
-            &QProgressBar::setValue);
-
-    connect(
-        watcher, &QFutureWatcher<convert::result_data_entry>::finished, [this, watcher] { onBatchFinish(*watcher); });
-
-    watcher->setFuture(QtConcurrent::mapped(filePaths, worker{reqWidth, reqHeight, useBase64, format}));
+    // 内容相同的文件只生成一次，大文件优先
+    startPlannedBatch(
+        filePaths,
+        [filePaths, profiler = activeProfiler](const std::function<void(int, int)> &progress) {
+            return BatchPlan::build(
+                static_cast<int>(filePaths.size()),
+                [&](int i) {
+                    const QFileInfo info(filePaths[i]);
+                    return info.isFile() ? info.size() : qint64{-1};
+                },
+                [&](int i) {
+                    BatchProfiler::Item timing(profiler.get(), filePaths[i]);
+                    return BatchProfiler::measure(BatchStage::Hash, [&] { return BatchPlan::hashFile(filePaths[i]); });
+                },
+                progress);
+        },
+        [w = worker{reqWidth, reqHeight, useBase64, format, filePaths, activeJournal, activeProfiler, {}}](
+            const BatchPlan &plan) {
+            QVector<int> jobs;
+            jobs.reserve(static_cast<int>(plan.jobs.size()));
+            for (const int index : plan.jobs) {
+                jobs.append(index);
+            }
+            worker job = w;
+            job.hashes = plan.hashes;
+            return QtConcurrent::mapped(jobs, job);
+        });
 }
 
 void BarcodeWidget::onDecodeToChemFileClicked() {
-    const QStringList filePaths = lastSelectedFiles.filter(fileExtensionRegex_image);
-    if (filePaths.empty()) {
+    // 图片文件直接解码；压缩包（如批量保存的 ZIP / TAR）展开为其中的图片条目
+    struct DecodeInput {
+        QString path;                                 /**< 路径，压缩包条目为 "压缩包路径/条目名" */
+        std::shared_ptr<const ArchiveReader> archive; /**< 来源压缩包，普通文件为空 */
+        int entry = -1;                               /**< 压缩包条目索引 */
+        int index = -1;                               /**< 输入序号 */
+        QByteArray hash;                              /**< 执行计划中算出的内容哈希，未计算时为空 */
+    };
+
+    QVector<DecodeInput> inputs;
+    QStringList badArchives;
+    for (const auto &file : lastSelectedFiles) {
+        if (fileExtensionRegex_image.match(file).hasMatch()) {
+            inputs.append({file, nullptr, -1, static_cast<int>(inputs.size())});
+        } else if (fileExtensionRegex_archive.match(file).hasMatch()) {
+            auto archive = std::make_shared<const ArchiveReader>(file);
+            if (!archive->isOpen()) {
+                badArchives.append(QString("• %1 (%2)").arg(QFileInfo(file).fileName(), archive->errorString()));
+                continue;
+            }
+            const auto &entries = archive->entries();
+            for (int i = 0; i < static_cast<int>(entries.size()); ++i) {
+                if (fileExtensionRegex_image.match(entries[i].name).hasMatch()) {
+                    inputs.append({QDir(file).filePath(entries[i].name), archive, i, static_cast<int>(inputs.size())});
+                }
+            }
+        }
+    }
+    QStringList filePaths;
+    filePaths.reserve(inputs.size());
+    for (const auto &input : inputs) {
+        filePaths.append(input.path);
+    }
+
+    if (!badArchives.isEmpty()) {
+        QMessageBox::warning(this, "警告", "以下压缩包无法读取:\n" + badArchives.join("\n"));
+    }
+    if (inputs.empty()) {
         QMessageBox::warning(this, "警告", "无可处理文件");
         return;
     }
@@ -553,29 +782,87 @@ void BarcodeWidget::onDecodeToChemFileClicked() {
     saveButton->setEnabled(false);
     this->setCursor(Qt::WaitCursor);
 
+    const bool useBase64 = base64CheckAcion->isChecked();
+    activeJournal = openJournal("decode", QString("base64=%1").arg(useBase64), filePaths);
+    activeProfiler = std::make_shared<BatchProfiler>();
+
     struct worker {
         using result_type = convert::result_data_entry;
 
         bool useBase64;
-        convert::result_data_entry operator()(QString path) const {
+        std::shared_ptr<BatchJournal> journal;
+        std::shared_ptr<BatchProfiler> profiler;
+        convert::result_data_entry operator()(const DecodeInput &input) const {
+            QString path = input.path;
+            BatchProfiler::Item timing(profiler.get(), path);
             try {
-                const auto file_path = path.toLocal8Bit().toStdString();
-                switch (auto rst = convert::QRcode_to_byte(file_path); rst.err) {
+                // 在内存中解码，断点续传需要用同一份数据计算内容哈希；
+                // 普通文件映射到内存后直接引用，file 须在 encoded 之前声明，保证映射比引用它的 encoded 活得久
+                QFile file;
+                QByteArray encoded;
+                {
+                    BatchProfiler::Stage stage(BatchStage::Read);
+                    if (input.archive) {
+                        encoded = input.archive->read(input.entry);
+                    } else if (file.setFileName(path); file.open(QIODevice::ReadOnly)) {
+                        const qint64 size = file.size();
+                        const bool mappable = size > 0 && size <= std::numeric_limits<int>::max();
+                        if (const uchar *mapped = mappable ? file.map(0, size) : nullptr) {
+                            const auto *bytes = reinterpret_cast<const char *>(mapped);
+                            encoded = QByteArray::fromRawData(bytes, static_cast<int>(size));
+                        } else {
+                            encoded = file.readAll();
+                        }
+                    }
+                }
+
+                // 执行计划已算过的哈希直接复用
+                QByteArray contentHash = input.hash;
+                if (journal && !encoded.isEmpty()) {
+                    if (contentHash.isEmpty()) {
+                        contentHash = BatchProfiler::measure(BatchStage::Hash, [&] {
+                            return BatchJournal::hashContent(encoded.constData(), encoded.size());
+                        });
+                    }
+                    if (const auto done = journal->findCompleted(input.index, contentHash)) {
+                        BatchProfiler::Stage stage(BatchStage::Read);
+                        if (QFile output(done->outputPath); output.open(QIODevice::ReadOnly)) {
+                            return {std::move(path), output.readAll()};
+                        }
+                    }
+                }
+
+                const cv::Mat image =
+                    BatchProfiler::measure(BatchStage::ImageDecode, [&] { return convert::decode_image(encoded); });
+                auto rst = BatchProfiler::measure(BatchStage::Detect, [&] { return convert::QRcode_to_byte(image); });
+                switch (rst.err) {
                 case convert::result_i2t::empty_img:
-                    spdlog::error("cv::imread 无法加载图片文件: {}", path.toStdString());
+                    spdlog::error("cv::imdecode 无法加载图片文件: {}", path.toStdString());
                     return {std::move(path), QString{"无法加载图片文件: %1"}.arg(path).toStdString()};
                 case convert::result_i2t::invalid_qrcode:
+                    if (journal) {
+                        journal->append({input.index, contentHash, {}, false});
+                    }
                     return {std::move(path), std::string{"无法识别条码或条码格式不正确"}};
                 default:
                     std::vector<std::uint8_t> decodedData;
                     if (useBase64) {
+                        BatchProfiler::Stage stage(BatchStage::Base64);
                         decodedData = SimpleBase64::decode(rst.text);
                     } else {
                         decodedData = std::vector<std::uint8_t>(rst.text.begin(), rst.text.end());
                     }
-                    return {std::move(path),
-                            QByteArray(reinterpret_cast<const char *>(decodedData.data()),
-                                       static_cast<int>(decodedData.size()))};
+                    QByteArray bytes(reinterpret_cast<const char *>(decodedData.data()),
+                                     static_cast<int>(decodedData.size()));
+                    if (journal) {
+                        BatchProfiler::Stage stage(BatchStage::Save);
+                        const QString outputPath = journal->outputPathFor(input.index, "rfa");
+                        QFile output(outputPath);
+                        const bool saved = output.open(QIODevice::WriteOnly) && output.write(bytes) == bytes.size();
+                        output.close();
+                        journal->append({input.index, contentHash, saved ? outputPath : QString{}, saved});
+                    }
+                    return {std::move(path), std::move(bytes)};
                 }
             } catch (const std::exception &e) {
                 return {std::move(path), QString("解码失败:\n%1").arg(e.what()).toStdString()};
@@ -583,17 +870,44 @@ void BarcodeWidget::onDecodeToChemFileClicked() {
         }
     };
 
-    auto *watcher = new QFutureWatcher<convert::result_data_entry>(this);
-
-    connect(watcher,
-            &QFutureWatcher<convert::result_data_entry>::progressValueChanged,
-            progressBar,
-            &QProgressBar::setValue);
-
-    connect(
-        watcher, &QFutureWatcher<convert::result_data_entry>::finished, [this, watcher] { onBatchFinish(*watcher); });
-
-    watcher->setFuture(QtConcurrent::mapped(filePaths, worker{base64CheckAcion->isChecked()}));
+    // 内容相同的图片（包括压缩包内的条目）只解码一次，大文件优先
+    startPlannedBatch(
+        filePaths,
+        [inputs, profiler = activeProfiler](const std::function<void(int, int)> &progress) {
+            return BatchPlan::build(
+                static_cast<int>(inputs.size()),
+                [&](int i) {
+                    const DecodeInput &input = inputs[i];
+                    if (input.archive) {
+                        return static_cast<qint64>(input.archive->entries()[input.entry].size);
+                    }
+                    const QFileInfo info(input.path);
+                    return info.isFile() ? info.size() : qint64{-1};
+                },
+                [&](int i) {
+                    const DecodeInput &input = inputs[i];
+                    BatchProfiler::Item timing(profiler.get(), input.path);
+                    if (input.archive) {
+                        const QByteArray data =
+                            BatchProfiler::measure(BatchStage::Read, [&] { return input.archive->read(input.entry); });
+                        return BatchProfiler::measure(BatchStage::Hash, [&] {
+                            return data.isEmpty() ? QByteArray{}
+                                                  : BatchJournal::hashContent(data.constData(), data.size());
+                        });
+                    }
+                    return BatchProfiler::measure(BatchStage::Hash, [&] { return BatchPlan::hashFile(input.path); });
+                },
+                progress);
+        },
+        [inputs, w = worker{useBase64, activeJournal, activeProfiler}](const BatchPlan &plan) {
+            QVector<DecodeInput> jobs;
+            jobs.reserve(static_cast<int>(plan.jobs.size()));
+            for (const int index : plan.jobs) {
+                jobs.append(inputs[index]);
+                jobs.back().hash = plan.hashes[index];
+            }
+            return QtConcurrent::mapped(jobs, w);
+        });
 }
 
 void BarcodeWidget::onSaveClicked() {
@@ -605,6 +919,7 @@ void BarcodeWidget::onSaveClicked() {
     struct SaveTask {
         convert::result_data_entry entry;
         QString dest;
+        QString encoded; /**< 批处理时已写入续传输出目录的结果文件，可直接复制，没有时为空 */
     };
 
     struct SaveResult {
@@ -619,6 +934,10 @@ void BarcodeWidget::onSaveClicked() {
     };
 
     QList<SaveTask> tasks;
+    std::shared_ptr<ArchiveWriter> archive; // 保存为单个压缩包时的写入器
+
+    // 内容相同的输入只处理了一次，只有代表项有结果文件，其余的照常编码
+    const auto journalOutput = [this](int index) { return activeJournal ? activeJournal->outputOf(index) : QString{}; };
 
     if (lastResults.size() == 1) {
         const auto &entry = lastResults.front();
@@ -638,7 +957,40 @@ void BarcodeWidget::onSaveClicked() {
         if (fileName.isEmpty()) {
             return;
         }
-        tasks.append({entry, std::move(fileName)});
+        tasks.append({entry, std::move(fileName), journalOutput(0)});
+    } else if (const QAction *mode = saveModeGroup->checkedAction(); mode && mode->data().toInt() >= 0) {
+        // 所有结果顺序写入同一个压缩包，避免大量小文件的元数据开销
+        const auto format = static_cast<ArchiveWriter::Format>(mode->data().toInt());
+        const bool isTar = format == ArchiveWriter::Format::Tar;
+        const QString defaultPath = QDir(QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation))
+                                        .filePath(isTar ? "results.tar" : "results.zip");
+        const QString archivePath = QFileDialog::getSaveFileName(
+            this, "保存压缩包", defaultPath, isTar ? "TAR Archives (*.tar)" : "ZIP Archives (*.zip)");
+        if (archivePath.isEmpty()) {
+            return;
+        }
+
+        archive = std::make_shared<ArchiveWriter>(archivePath, format);
+        if (!archive->isOpen()) {
+            QMessageBox::warning(this, "警告", QString("无法创建压缩包: %1").arg(archive->errorString()));
+            return;
+        }
+
+        // 不同输入可能得到相同的默认文件名，压缩包内的条目名不能重复
+        QHash<QString, int> usedNames;
+        for (int i = 0; i < static_cast<int>(lastResults.size()); ++i) {
+            const auto &entry = lastResults[i];
+            if (!entry) {
+                continue;
+            }
+
+            QString name = entry.get_default_target_name();
+            if (const int n = usedNames[name]++; n > 0) {
+                const QFileInfo info(name);
+                name = QString("%1 (%2).%3").arg(info.completeBaseName()).arg(n).arg(info.suffix());
+            }
+            tasks.append({entry, std::move(name), journalOutput(i)});
+        }
     } else {
         const QString dir =
             QFileDialog::getExistingDirectory(this,
@@ -651,13 +1003,14 @@ void BarcodeWidget::onSaveClicked() {
         }
 
         const QDir outputDir(dir);
-        for (const auto &entry : lastResults) {
+        for (int i = 0; i < static_cast<int>(lastResults.size()); ++i) {
+            const auto &entry = lastResults[i];
             if (!entry) {
                 continue;
             }
 
             const QString fileName = outputDir.filePath(entry.get_default_target_name());
-            tasks.append({entry, std::move(fileName)});
+            tasks.append({entry, std::move(fileName), journalOutput(i)});
         }
     }
 
@@ -673,9 +1026,23 @@ void BarcodeWidget::onSaveClicked() {
     decodeToChemFile->setEnabled(false);
     this->setCursor(Qt::WaitCursor);
 
+    // 保存同样分项计时，完成后的报告取代上次批处理的报告
+    auto profiler = std::make_shared<BatchProfiler>();
+
     struct worker {
         using result_type = SaveResult;
+        std::shared_ptr<BatchProfiler> profiler;
+
         SaveResult operator()(const SaveTask &task) const noexcept try {
+            BatchProfiler::Item timing(profiler.get(), task.dest);
+            BatchProfiler::Stage stage(BatchStage::Save);
+            // 批处理时已编码好的结果直接复制；复制失败（如输出目录已被清理）时照常编码
+            if (!task.encoded.isEmpty()) {
+                QFile::remove(task.dest);
+                if (QFile::copy(task.encoded, task.dest)) {
+                    return {SaveResult::success, task.dest};
+                }
+            }
             return std::visit<SaveResult>(
                 overload_def_noop{std::in_place_type<SaveResult>,
                                   [&](const QImage &img) -> SaveResult {
@@ -706,11 +1073,38 @@ void BarcodeWidget::onSaveClicked() {
         } catch (...) { return {SaveResult::failed}; }
     };
 
+    // 写入压缩包：PNG 编码在工作线程中完成，写入由 ArchiveWriter 的写线程顺序进行
+    struct archive_worker {
+        using result_type = SaveResult;
+        std::shared_ptr<ArchiveWriter> archive;
+        std::shared_ptr<BatchProfiler> profiler;
+
+        SaveResult operator()(const SaveTask &task) const noexcept try {
+            BatchProfiler::Item timing(profiler.get(), task.dest);
+            BatchProfiler::Stage stage(BatchStage::Save);
+            QByteArray bytes;
+            if (QFile encoded(task.encoded); !task.encoded.isEmpty() && encoded.open(QIODevice::ReadOnly)) {
+                bytes = encoded.readAll();
+            } else if (const auto *img = std::get_if<QImage>(&task.entry.data); img && !img->isNull()) {
+                QBuffer buffer(&bytes);
+                if (buffer.open(QIODevice::WriteOnly)) {
+                    img->save(&buffer, "PNG");
+                }
+            } else if (const auto *data = std::get_if<QByteArray>(&task.entry.data)) {
+                bytes = *data;
+            }
+            if (bytes.isEmpty()) {
+                return {SaveResult::invalid_data, task.dest};
+            }
+            return {archive->add(task.dest, bytes) ? SaveResult::success : SaveResult::failed, task.dest};
+        } catch (...) { return {SaveResult::failed, task.dest}; }
+    };
+
     auto *watcher = new QFutureWatcher<SaveResult>(this);
 
     connect(watcher, &QFutureWatcher<SaveResult>::progressValueChanged, progressBar, &QProgressBar::setValue);
 
-    connect(watcher, &QFutureWatcher<SaveResult>::finished, [this, watcher]() {
+    connect(watcher, &QFutureWatcher<SaveResult>::finished, [this, watcher, archive, profiler]() {
         this->setCursor(Qt::ArrowCursor);
         progressBar->setVisible(false);
 
@@ -719,6 +1113,17 @@ void BarcodeWidget::onSaveClicked() {
         saveButton->setEnabled(true);
         // 保存按钮总是可以再次点击
 
+        // 压缩包写完目录区后才算保存成功
+        const bool archiveFailed = archive && !archive->close();
+        profiler->stop();
+        lastReport = profiler->report();
+        spdlog::info("保存性能报告:\n{}", lastReport->toText().toStdString());
+        if (archiveFailed) {
+            QMessageBox::warning(this, "保存失败", QString("写入压缩包失败: %1").arg(archive->errorString()));
+            watcher->deleteLater();
+            return;
+        }
+
         auto list = watcher->future().results();
 
         int successCount = 0;
@@ -773,7 +1178,8 @@ void BarcodeWidget::onSaveClicked() {
         watcher->deleteLater();
     });
 
-    watcher->setFuture(QtConcurrent::mapped(tasks, worker{}));
+    watcher->setFuture(archive ? QtConcurrent::mapped(tasks, archive_worker{archive, profiler})
+                               : QtConcurrent::mapped(tasks, worker{profiler}));
 }
 
 void BarcodeWidget::showAbout() const {
@@ -807,7 +1213,15 @@ QImage BarcodeWidget::MatToQImage(const cv::Mat &mat) const {
     return {};
 }
 
-void BarcodeWidget::renderResults() const {
+void BarcodeWidget::renderResults() {
+    if (lastResults.size() > 1) {
+        // 多个结果交给列表视图，只重置模型，不创建任何控件
+        resultModel->reset();
+        resultStack->setCurrentWidget(resultView);
+        return;
+    }
+    resultStack->setCurrentWidget(scrollArea);
+
     QWidget *container = new QWidget();
     // 容器背景设为透明或跟随 ScrollArea
     container->setStyleSheet("background-color: transparent;");
@@ -822,8 +1236,6 @@ void BarcodeWidget::renderResults() const {
         return;
     }
 
-    constexpr int maxColumns = 4; // 每行最多4个 (仅用于多结果)
-
     if (lastResults.empty()) {
         if (!lastSelectedFiles.empty()) {
             QVBoxLayout *listLayout = new QVBoxLayout(container);
@@ -875,6 +1287,23 @@ void BarcodeWidget::renderResults() const {
                 }
                 iconLabel->setPixmap(iconPix);
 
+                if (isImage) {
+                    // 图片文件换成真实缩略图，后台生成完成前先显示上面的默认图标
+                    const QPixmap thumbnail = ThumbnailService::instance().thumbnail(
+                        ThumbnailService::keyFor(filePath),
+                        iconLabel->size(),
+                        filePath,
+                        iconLabel,
+                        [iconLabel](const QPixmap &pixmap) {
+                            if (!pixmap.isNull()) {
+                                iconLabel->setPixmap(pixmap);
+                            }
+                        });
+                    if (!thumbnail.isNull()) {
+                        iconLabel->setPixmap(thumbnail);
+                    }
+                }
+
                 // 3. 文件名
                 QLabel *nameLabel = new QLabel(fileName);
                 nameLabel->setStyleSheet(
@@ -969,108 +1398,158 @@ void BarcodeWidget::renderResults() const {
         if (contentWidget) {
             singleLayout->addWidget(contentWidget, 1); // 权重设为 1 占据空间
         }
-    } else {
-        // --- 多个结果网格展示逻辑 (保持原样) ---
-        QGridLayout *gridLayout = new QGridLayout(container);
-        gridLayout->setHorizontalSpacing(20);
-        gridLayout->setVerticalSpacing(40);
-        gridLayout->setContentsMargins(20, 20, 20, 20);
-
-        int count = 0;
-
-        for (const auto &entry : lastResults) {
-            int row = count / maxColumns;
-            int col = count % maxColumns;
-
-            QWidget *cellWidget = new QWidget();
-            QVBoxLayout *cellLayout = new QVBoxLayout(cellWidget);
-            cellLayout->setContentsMargins(0, 0, 0, 0);
-            cellLayout->setSpacing(5);
-
-            QWidget *contentWidget = nullptr;
-
-            std::visit(
-                overload_def_noop{
-                    std::in_place_type<void>,
-                    // 图片类型，显示缩略图
-                    [&](const QImage &img) {
-                        QLabel *imgLabel = new QLabel();
-                        // 使用缩略图大小 200x200
-                        imgLabel->setPixmap(
-                            QPixmap::fromImage(img).scaled(200, 200, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-                        imgLabel->setAlignment(Qt::AlignCenter);
-                        imgLabel->setStyleSheet("border: 1px solid #ddd; background: white;");
-                        imgLabel->setToolTip(QString("Size: %1x%2").arg(img.width()).arg(img.height()));
-                        contentWidget = imgLabel;
-                    },
-                    // 文本类型，显示前200字符 (截断)
-                    [&](const QByteArray &data) {
-                        QLabel *textLabel = new QLabel();
-                        QString textDisplay = QString::fromUtf8(data);
-                        if (textDisplay.length() > 256) {
-                            textDisplay = textDisplay.left(256) + "...";
-                        }
-                        textLabel->setText(textDisplay);
-                        textLabel->setWordWrap(true);
-
-                        textLabel->setAlignment(Qt::AlignTop | Qt::AlignLeft);
-
-                        textLabel->setStyleSheet(
-                            "border: 1px solid #ddd; background: white; padding: 5px; font-family: Consolas;");
-                        textLabel->setFixedSize(200, 200);
-                        contentWidget = textLabel;
-                    },
-                    // 错误信息，显示解码或生成的错误内容
-                    [&](const std::string &str) {
-                        QLabel *errLabel = new QLabel(QString::fromStdString(str));
-                        errLabel->setStyleSheet(
-                            "font-size: 15pt; color: red; border: 1px solid red; background: #fff0f0; padding: 5px;");
-                        errLabel->setWordWrap(true);
-
-                        errLabel->setAlignment(Qt::AlignTop | Qt::AlignLeft);
-
-                        errLabel->setFixedSize(200, 200);
-                        contentWidget = errLabel;
-                    }},
-                entry.data);
-
-            if (contentWidget) {
-                // 仅在多结果模式下渲染文件名
-                QString fileNameStr = QFileInfo(entry.source_file_name).fileName();
-                if (fileNameStr.isEmpty()) {
-                    fileNameStr = "Unknown";
+    }
+
+    scrollArea->setWidget(container);
+}
+
+void BarcodeWidget::startPlannedBatch(const QStringList &sources,
+                                      std::function<BatchPlan(const std::function<void(int, int)> &)> makePlan,
+                                      std::function<QFuture<convert::result_data_entry>(const BatchPlan &)> launch) {
+    // 生成计划期间先显示为忙碌状态，开始比对重复内容后显示哈希进度
+    progressBar->setRange(0, 0);
+    summaryLabel->setVisible(false);
+    // 计划中的哈希计入 Hash 阶段，吞吐量也从这里开始计时
+    if (activeProfiler) {
+        activeProfiler->start();
+    }
+
+    auto *watcher = new QFutureWatcher<BatchPlan>(this);
+    planWatcher = watcher;
+    const auto progress = [this, watcher](int done, int total) {
+        QMetaObject::invokeMethod(
+            this,
+            [this, watcher, done, total] {
+                // 进度按完成顺序排队到达，只增不减；计划已被取代时不再更新
+                if (watcher == planWatcher && done > progressBar->value()) {
+                    progressBar->setRange(0, total);
+                    progressBar->setValue(done);
                 }
+            },
+            Qt::QueuedConnection);
+    };
+    connect(watcher, &QFutureWatcher<BatchPlan>::finished, this, [this, watcher, sources, launch = std::move(launch)] {
+        watcher->deleteLater();
+        if (watcher != planWatcher) {
+            return;
+        }
+        planWatcher = nullptr;
+
+        BatchPlan plan = watcher->result();
+        if (plan.duplicateCount > 0) {
+            spdlog::info("批处理共 {} 项，其中 {} 项内容重复，实际处理 {} 项",
+                         plan.total,
+                         plan.duplicateCount,
+                         plan.jobs.size());
+        }
+        startBatch(launch(plan), sources, std::move(plan));
+    });
+    watcher->setFuture(QtConcurrent::run([makePlan = std::move(makePlan), progress] { return makePlan(progress); }));
+}
+
+void BarcodeWidget::replaceResults(std::vector<convert::result_data_entry> results) {
+    resultModel->beginResultsChange();
+    lastResults = std::move(results);
+    resultModel->endResultsChange();
+}
+
+void BarcodeWidget::startBatch(const QFuture<convert::result_data_entry> &future,
+                               const QStringList &sources,
+                               BatchPlan plan) {
+    // 先按输入数占位，结果完成后按索引填入，保证显示顺序与输入顺序一致
+    replaceResults(std::vector<convert::result_data_entry>(plan.total));
+    pendingResultIndices.clear();
+    planWatcher = nullptr; // 尚未完成的执行计划已被本次批处理取代
+    activeSources = sources;
+    activePlan = std::move(plan);
+    renderResults();
+
+    progressBar->setRange(0, static_cast<int>(activePlan.jobs.size()));
+    progressBar->setValue(0);
+    summaryLabel->setVisible(false);
+
+    auto *watcher = new QFutureWatcher<convert::result_data_entry>(this);
+    activeWatcher = watcher;
+
+    connect(watcher,
+            &QFutureWatcher<convert::result_data_entry>::progressValueChanged,
+            progressBar,
+            &QProgressBar::setValue);
+
+    connect(watcher, &QFutureWatcher<convert::result_data_entry>::resultReadyAt, this, [this, watcher](int index) {
+        if (watcher == activeWatcher) {
+            pendingResultIndices.push_back(index);
+        }
+    });
 
-                QLabel *nameLabel = new QLabel(fileNameStr);
-                nameLabel->setAlignment(Qt::AlignCenter);
-                nameLabel->setStyleSheet("font-size: 10pt; color: #333; font-weight: bold;");
-                nameLabel->setFixedWidth(200);
-                nameLabel->setToolTip(entry.source_file_name);
+    connect(
+        watcher, &QFutureWatcher<convert::result_data_entry>::finished, [this, watcher] { onBatchFinish(*watcher); });
 
-                QFontMetrics metrics(nameLabel->font());
-                QString elidedText = metrics.elidedText(fileNameStr, Qt::ElideMiddle, 200);
-                nameLabel->setText(elidedText);
+    resultFlushTimer->start();
+    watcher->setFuture(future);
+}
 
-                cellLayout->addWidget(nameLabel);
+void BarcodeWidget::flushPendingResults() {
+    if (!activeWatcher || pendingResultIndices.empty()) {
+        return;
+    }
 
-                cellLayout->addWidget(contentWidget);
+    std::vector<int> ready;
+    ready.swap(pendingResultIndices);
 
-                gridLayout->addWidget(cellWidget, row, col, Qt::AlignTop);
+    // 一个任务的结果分发到所有内容相同的输入；批处理过程中用户可能重新选择了文件，lastResults 已被清空
+    std::vector<int> updated;
+    updated.reserve(ready.size());
+    for (const int job : ready) {
+        if (job < 0 || job >= static_cast<int>(activePlan.targets.size())) {
+            continue;
+        }
+        const convert::result_data_entry result = activeWatcher->resultAt(job);
+        for (const int target : activePlan.targets[job]) {
+            if (target >= static_cast<int>(lastResults.size())) {
+                continue;
             }
-            count++;
+            lastResults[target] = result;
+            if (target != activePlan.jobs[job] && target < activeSources.size()) {
+                lastResults[target].source_file_name = activeSources[target];
+            }
+            updated.push_back(target);
         }
     }
 
-    scrollArea->setWidget(container);
+    // 单个结果以原图展示，等批处理完成后整体渲染
+    if (lastResults.size() > 1) {
+        resultModel->updateRows(updated);
+    }
 }
 
 void BarcodeWidget::onBatchFinish(QFutureWatcher<convert::result_data_entry> &watcher) {
+    if (&watcher != activeWatcher) {
+        // 已被新的批处理取代
+        watcher.deleteLater();
+        return;
+    }
+
+    flushPendingResults();
+    resultFlushTimer->stop();
+    activeWatcher = nullptr;
+
+    // 所有工作线程都已完成，汇总分阶段计时
+    lastReport.reset();
+    if (activeProfiler) {
+        activeProfiler->stop();
+        lastReport = activeProfiler->report();
+        activeProfiler.reset();
+        spdlog::info("批处理性能报告:\n{}", lastReport->toText().toStdString());
+    }
+
     setCursor(Qt::ArrowCursor);
     if (lastSelectedFiles.size() == 1) {
         auto &file = lastSelectedFiles.front();
         bool isImage = fileExtensionRegex_image.match(file).hasMatch();
+        bool isArchive = fileExtensionRegex_archive.match(file).hasMatch();
         generateButton->setEnabled(!isImage);
-        decodeToChemFile->setEnabled(isImage);
+        decodeToChemFile->setEnabled(isImage || isArchive);
     } else if (!lastSelectedFiles.isEmpty()) {
         generateButton->setEnabled(true);
         decodeToChemFile->setEnabled(true);
@@ -1078,22 +1557,97 @@ void BarcodeWidget::onBatchFinish(QFutureWatcher<convert::result_data_entry> &wa
 
     progressBar->setVisible(false);
 
-    QList<convert::result_data_entry> results = watcher.future().results();
-
-    lastResults.clear();
-    lastResults.reserve(results.size());
-    for (auto &item : results) {
-        lastResults.push_back(std::move(item));
+    // 完成摘要，包含去重节省的工作量
+    const auto succeeded =
+        std::ranges::count_if(lastResults, [](const auto &entry) { return static_cast<bool>(entry); });
+    QString summary = QString("完成 %1 项：成功 %2，失败 %3")
+                          .arg(lastResults.size())
+                          .arg(succeeded)
+                          .arg(static_cast<qint64>(lastResults.size()) - succeeded);
+    if (activePlan.duplicateCount > 0) {
+        summary += QString("；其中 %1 项内容重复，直接复用结果（少处理 %2）")
+                       .arg(activePlan.duplicateCount)
+                       .arg(QLocale().formattedDataSize(activePlan.duplicateBytes));
     }
+    if (lastReport) {
+        summary = summary.toHtmlEscaped() + QString("，%1 项/秒　<a href=\"report\">性能报告</a>")
+                                                .arg(lastReport->itemsPerSecond, 0, 'f', 1);
+    }
+    summaryLabel->setText(summary);
+    summaryLabel->setVisible(!lastResults.empty());
 
     if (!lastResults.empty()) {
         saveButton->setEnabled(true);
-        renderResults(); // 批量渲染结果
+        if (lastResults.size() == 1) {
+            renderResults();
+        }
     }
 
     watcher.deleteLater();
 }
 
+void BarcodeWidget::showBatchReport() {
+    if (!lastReport) {
+        return;
+    }
+
+    QDialog dialog(this);
+    dialog.setWindowTitle("批处理性能报告");
+    dialog.resize(720, 480);
+    auto *layout = new QVBoxLayout(&dialog);
+
+    auto *text = new QPlainTextEdit(lastReport->toText(), &dialog);
+    text->setReadOnly(true);
+    text->setLineWrapMode(QPlainTextEdit::NoWrap);
+    text->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    layout->addWidget(text);
+
+    auto *buttons = new QDialogButtonBox(QDialogButtonBox::Close, &dialog);
+    auto *exportButton = buttons->addButton("导出 JSON", QDialogButtonBox::ActionRole);
+    layout->addWidget(buttons);
+    connect(buttons, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
+    connect(exportButton, &QPushButton::clicked, &dialog, [this, &dialog] {
+        const QString path =
+            QFileDialog::getSaveFileName(&dialog, "导出性能报告", "batch_report.json", "JSON Files (*.json)");
+        if (path.isEmpty()) {
+            return;
+        }
+        QFile file(path);
+        const QByteArray json = lastReport->toJson();
+        if (!file.open(QIODevice::WriteOnly) || file.write(json) != json.size()) {
+            QMessageBox::warning(&dialog, "警告", QString("导出失败: %1").arg(file.errorString()));
+        }
+    });
+
+    dialog.exec();
+}
+
+std::shared_ptr<BatchJournal>
+BarcodeWidget::openJournal(const QString &mode, const QString &options, const QStringList &inputs) {
+    const QString key = BatchJournal::makeKey(mode, options, inputs);
+    if (!resumeAction->isChecked() || (activeJournal && activeJournal->key() != key)) {
+        discardJournal();
+    }
+    if (!resumeAction->isChecked()) {
+        return nullptr;
+    }
+
+    // 重新运行同一个批处理：先关闭旧的日志（写出缓冲区），新实例才能加载本次会话中已完成的项
+    activeJournal.reset();
+    auto journal = std::make_shared<BatchJournal>(QStringLiteral("./batch_journal"), key);
+    if (const int done = journal->completedCount(); done > 0) {
+        spdlog::info("检测到未完成的批处理，{}/{} 项将直接复用上次的结果", done, inputs.size());
+    }
+    return journal;
+}
+
+void BarcodeWidget::discardJournal() {
+    if (activeJournal) {
+        activeJournal->finish();
+        activeJournal.reset();
+    }
+}
+
 template <>
 struct magic_enum::customize::enum_range<ZXing::BarcodeFormat> {
     static constexpr bool is_flags = true;
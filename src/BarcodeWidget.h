@@ -1,5 +1,8 @@
 #pragma once
 
+#include <functional>
+#include <memory>
+#include <optional>
 #include <vector>
 
 #include <QWidget>
@@ -8,6 +11,8 @@
 #include <qfuturewatcher.h>
 
 #include "CameraWidget.h"
+#include "batch/BatchPlan.h"
+#include "batch/BatchProfiler.h"
 #include "convert.h"
 #include "mqtt/MQTTMessageWidget.h"
 #include "mqtt/mqtt_client.h"
@@ -21,6 +26,12 @@ class QComboBox;
 class QFileDialog;
 class QProgressBar;
 class QMenuBar;
+class QTimer;
+class QListView;
+class QStackedWidget;
+class QActionGroup;
+class ResultListModel;
+class BatchJournal;
 
 /**
  * @class BarcodeWidget
@@ -98,7 +109,28 @@ private slots:
     /**
     * @brief 渲染并显示结果
     */
-    void renderResults() const;
+    void renderResults();
+
+    /**
+     * @brief 替换全部结果；结果列表模型引用 lastResults，修改前后必须重置模型
+     * @param results 新的结果
+     */
+    void replaceResults(std::vector<convert::result_data_entry> results);
+
+    /**
+     * @brief 启动批处理任务，单项结果完成后即增量刷新到界面
+     * @param future 批处理任务，第 i 个结果对应 plan.jobs[i]
+     * @param sources 原始输入名称，用于内容重复的输入
+     * @param plan 执行计划
+     */
+    void startBatch(const QFuture<convert::result_data_entry> &future, const QStringList &sources, BatchPlan plan);
+
+    /**
+     * @brief 将已完成但尚未显示的结果写入 lastResults 并追加到界面
+     *
+     * 由定时器每 50ms 调用一次，把这段时间内完成的结果合并为一次界面更新。
+     */
+    void flushPendingResults();
 
     /**
     * @brief 批处理完成回调函数
@@ -106,6 +138,25 @@ private slots:
     */
     void onBatchFinish(QFutureWatcher<convert::result_data_entry> &watcher);
 
+    /**
+     * @brief 打开批处理断点续传日志，未启用断点续传时返回空
+     * @param mode 批处理模式
+     * @param options 影响结果的参数
+     * @param inputs 输入文件路径
+     * @return 批处理日志，由工作线程共享
+     */
+    std::shared_ptr<BatchJournal> openJournal(const QString &mode, const QString &options, const QStringList &inputs);
+
+    /**
+     * @brief 当前结果不再需要时删除其断点续传日志和输出目录
+     */
+    void discardJournal();
+
+    /**
+     * @brief 显示上次批处理的性能报告，可导出为 JSON
+     */
+    void showBatchReport();
+
     /**
      * @brief 将条码格式枚举转换为字符串表示。
      *
@@ -123,26 +174,52 @@ private slots:
     static ZXing::BarcodeFormat stringToBarcodeFormat(const QString &formatStr);
 
 private:
+    /**
+     * @brief 先在后台生成执行计划（内容去重、大文件优先），再启动批处理任务
+     * @param sources 原始输入名称
+     * @param makePlan 生成执行计划，在后台线程中执行；参数为传给 BatchPlan::build 的进度回调
+     * @param launch 按执行计划启动批处理任务，在界面线程中执行
+     */
+    void startPlannedBatch(const QStringList &sources,
+                           std::function<BatchPlan(const std::function<void(int, int)> &)> makePlan,
+                           std::function<QFuture<convert::result_data_entry>(const BatchPlan &)> launch);
+
     QStringList lastSelectedFiles; /**< 上次选择的文件路径列表 */
 
-    QMenuBar *menuBar;  /**< 主菜单栏 */
-    QMenu *helpMenu;    /**< 帮助菜单 */
-    QMenu *toolsMenu;   /**< 工具菜单 */
-    QMenu *settingMenu; /**< 设置菜单 */
+    QMenuBar *menuBar;   /**< 主菜单栏 */
+    QMenu *helpMenu;     /**< 帮助菜单 */
+    QMenu *toolsMenu;    /**< 工具菜单 */
+    QMenu *settingMenu;  /**< 设置菜单 */
+    QMenu *saveModeMenu; /**< 批量保存方式菜单 */
 
     QAction *aboutAction;          /**< "关于"操作 */
     QAction *debugMqttAction;      /**< 打开MQTT消息展示窗口 */
     QAction *openCameraScanAction; /**< 启动摄像头扫描条码 */
     QAction *base64CheckAcion;     /**< 启用Base64编码/解码 */
     QAction *directTextAction;     /**< 启用文本输入*/
+    QAction *resumeAction;         /**< 启用批处理断点续传 */
+    QActionGroup *saveModeGroup;   /**< 批量保存方式（逐个文件 / ZIP / TAR） */
 
     QLineEdit *filePathEdit;                                                  /**< 文件路径输入框 */
     QPushButton *generateButton;                                              /**< 生成条码按钮 */
     QPushButton *decodeToChemFile;                                            /**< 解码并保存为化验文件 */
     QPushButton *saveButton;                                                  /**< 保存条码图片按钮 */
     QProgressBar *progressBar;                                                /**< 异步进度条 */
+    QLabel *summaryLabel;                                                     /**< 批处理完成摘要 */
     std::vector<convert::result_data_entry> lastResults;                      /**< 上次解码结果 */
+    QFutureWatcher<convert::result_data_entry> *activeWatcher = nullptr;      /**< 当前批处理任务监视器 */
+    std::vector<int> pendingResultIndices;                                    /**< 已完成、待刷新到界面的结果索引 */
+    QTimer *resultFlushTimer;                                                 /**< 批处理结果增量刷新定时器 */
+    std::shared_ptr<BatchJournal> activeJournal;                              /**< 当前结果的续传日志和输出目录 */
+    QFutureWatcher<BatchPlan> *planWatcher = nullptr;                         /**< 正在生成的执行计划 */
+    BatchPlan activePlan;                                                     /**< 当前批处理的执行计划 */
+    QStringList activeSources;                                                /**< 当前批处理的原始输入名称 */
+    std::shared_ptr<BatchProfiler> activeProfiler;                            /**< 当前批处理的分阶段计时 */
+    std::optional<BatchProfiler::Report> lastReport;                          /**< 上次批处理或保存的性能报告 */
     QScrollArea *scrollArea;                                                  /**< 滚动区域 */
+    QListView *resultView;                                                    /**< 多结果网格视图 */
+    ResultListModel *resultModel;                                             /**< 多结果网格模型 */
+    QStackedWidget *resultStack;                                              /**< 单结果 / 多结果展示切换 */
     QComboBox *formatComboBox;                                                /**< 条码格式选择框 */
     ZXing::BarcodeFormat currentBarcodeFormat = ZXing::BarcodeFormat::QRCode; /**< 当前选择的条码格式 */
     QLineEdit *widthInput;                                                    /**< 图片宽度输入框 */
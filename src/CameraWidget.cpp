@@ -1,27 +1,34 @@
 #include "CameraWidget.h"
-#include "sysinfo.h"
-#include <QBuffer>
+#include "camera/DetectorBenchmark.h"
+#include "camera/FramePacer.h"
+#include "camera/MatAllocationCounter.h"
+#include "camera/SessionRecorder.h"
+#include "components/ScanResultModel.h"
 #include <QCameraInfo>
 #include <QComboBox>
 #include <QDateTime>
+#include <QDialog>
 #include <QDir>
 #include <QFile>
 #include <QFileDialog>
+#include <QFileInfo>
+#include <QFutureWatcher>
 #include <QGroupBox>
 #include <QHeaderView>
+#include <QInputDialog>
 #include <QLabel>
 #include <QMenuBar>
 #include <QMessageBox>
 #include <QMetaObject>
 #include <QPushButton>
-#include <QStandardItemModel>
 #include <QStandardPaths>
 #include <QTableView>
 #include <QTimer>
 #include <QToolButton>
 #include <QWidgetAction>
+#include <QtConcurrent>
 #include <ZXing/ReadBarcode.h>
-#include <filesystem>
+#include <algorithm>
 #include <magic_enum/magic_enum_format.hpp>
 #include <qaction.h>
 #include <qcoreevent.h>
@@ -71,34 +78,56 @@ static ZXing::ImageView ImageViewFromMat(const cv::Mat &image) {
         return {nullptr, 0, 0, ImageFormat::None};
     }
 
-    return {image.data, image.cols, image.rows, fmt};
+    // 传入行跨度，ROI 子图（非连续内存）也能直接识别而无需复制
+    return {image.data, image.cols, image.rows, fmt, static_cast<int>(image.step)};
 }
 
 /**
- * @brief 在图像上绘制条码的边界框和文本
+ * @brief 合并识别结果时，把未显示的旧结果中新出现的条码并入新结果
  *
- * @param img 输入输出图像，绘制条形码的边界框和文本
- * @param bc 条码对象，包含条码的位置信息和识别的文本
+ * 每个条码只报告一次“新出现”，旧结果被覆盖时若丢掉这些条码，它们就永远不会出现在结果列表中。
+ * 轮廓仍使用新结果的，保证叠加层跟随最新画面；新结果本身没有新条码时改用旧结果的帧，用于调试保存。
+ * @param older 被覆盖的旧结果
+ * @param newer 新结果
  */
-static void DrawBarcode(cv::Mat &img, const ZXing::Barcode &bc) {
-    const auto pos = bc.position();
-    const auto cvp = [](ZXing::PointI p) { return cv::Point(p.x, p.y); };
-    const std::vector<cv::Point> pts = {cvp(pos[0]), cvp(pos[1]), cvp(pos[2]), cvp(pos[3])};
-    cv::polylines(img, pts, true, CV_RGB(0, 255, 0));
-    cv::putText(img, bc.text(), cvp(pos[3]) + cv::Point(0, 20), cv::FONT_HERSHEY_DUPLEX, 0.5, CV_RGB(0, 255, 0));
+static void keepNewCodes(const FrameResult &older, FrameResult &newer) {
+    const bool newerHasNew = std::ranges::any_of(newer.codes, &ScannedCode::isNew);
+    bool carried = false;
+    for (const auto &code : older.codes) {
+        if (code.isNew && std::ranges::none_of(newer.codes, [&](const auto &c) { return c.trackId == code.trackId; })) {
+            newer.codes.push_back(code);
+            carried = true;
+        }
+    }
+    if (carried) {
+        newer.hasBarcode = true;
+        if (!newerHasNew) {
+            newer.frame = older.frame;
+        }
+    }
+}
+
+/**
+ * @brief 条码位置的外接矩形
+ */
+static cv::Rect boundingBoxOf(const ZXing::Position &position) {
+    std::vector<cv::Point> corners;
+    for (const auto &p : position) {
+        corners.emplace_back(p.x, p.y);
+    }
+    return cv::boundingRect(corners);
 }
 
 /**
  * @brief 将多边形区域修正为矩形图片
  *        为了不裁剪到条码，增加了一定的边距
  * @param img 原始图像
- * @param bc 条码对象，包含条码的位置信息和识别的文本
+ * @param corners 条码在 img 中的位置
  * @param enhance 是否对结果进行图像增强
  *                如果为 true，则对修正后的图像进行增强处理（对比度拉伸与亮度非线性映射），以提高条码的可读性。
  * @return 修正后的矩形图片
  */
-cv::Mat RectifyPolygonToRect(const cv::Mat &img, const ZXing::Barcode &bc, bool enhance) {
-    const auto corners = bc.position();
+cv::Mat RectifyPolygonToRect(const cv::Mat &img, const ZXing::Position &corners, bool enhance) {
     const std::vector<cv::Point2f> barcodeCorners = {
         cv::Point2f(corners[0].x, corners[0].y),
         cv::Point2f(corners[1].x, corners[1].y),
@@ -137,38 +166,42 @@ cv::Mat RectifyPolygonToRect(const cv::Mat &img, const ZXing::Barcode &bc, bool
     std::vector<cv::Point2f> marginBarcodeCorners(4);
     cv::perspectiveTransform(rectCornersWithMargin, marginBarcodeCorners, toBarcodeTransform);
     cv::Mat toOutputRectTransform = cv::getPerspectiveTransform(marginBarcodeCorners, outputRect);
-    cv::Mat rectifiedImage;
-    cv::warpPerspective(img, rectifiedImage, toOutputRectTransform, cv::Size(outputSize, outputSize));
     if (!enhance) {
+        cv::Mat rectifiedImage;
+        cv::warpPerspective(img, rectifiedImage, toOutputRectTransform, cv::Size(outputSize, outputSize));
         return rectifiedImage;
     }
 
-    if (rectifiedImage.channels() == 1) {
-        cv::cvtColor(rectifiedImage, rectifiedImage, cv::COLOR_GRAY2BGR);
-    } else if (rectifiedImage.channels() == 4) {
-        cv::cvtColor(rectifiedImage, rectifiedImage, cv::COLOR_BGRA2BGR);
-    } else if (rectifiedImage.channels() != 3) {
-        return rectifiedImage; // 不支持的通道数，直接返回原图
-    }
+    // 中间结果按线程复用，只有返回的增强结果需要新分配
+    thread_local struct {
+        cv::Mat rectified;
+        cv::Mat hist;
+        cv::Mat curve;
+        cv::Mat square;
+        cv::Mat factor;
+        std::vector<cv::Mat> tables;
+        cv::Mat lut;
+    } scratch;
+    cv::Mat &rectifiedImage = scratch.rectified;
+    cv::warpPerspective(img, rectifiedImage, toOutputRectTransform, cv::Size(outputSize, outputSize));
 
-    std::vector<int> bCount(256, 0), gCount(256, 0), rCount(256, 0);
-    for (int y = 0; y < rectifiedImage.rows; y++) {
-        const auto row = rectifiedImage.ptr<cv::Vec3b>(y);
-        for (int x = 0; x < rectifiedImage.cols; x++) {
-            bCount[row[x][0]]++;
-            gCount[row[x][1]]++;
-            rCount[row[x][2]]++;
-        }
+    // 灰度图（亮度模式）只增强一个通道，彩色图逐通道增强
+    if (rectifiedImage.channels() == 4) {
+        cv::cvtColor(rectifiedImage, rectifiedImage, cv::COLOR_BGRA2BGR);
+    } else if (rectifiedImage.channels() != 1 && rectifiedImage.channels() != 3) {
+        return rectifiedImage.clone(); // 不支持的通道数，直接返回原图
     }
+    const int cn = rectifiedImage.channels();
 
-    const auto calc_lo_hi = [](const std::vector<int> &count) -> std::pair<int, int> {
+    const auto calc_lo_hi = [](const cv::Mat &hist) -> std::pair<int, int> {
+        const auto count = [&](int v) { return static_cast<int>(hist.at<float>(v)); };
         int total = 0;
         for (int v = 0; v < 256; v++) {
-            total += count[v];
+            total += count(v);
         }
         int lo = 0, lo_sum = 0;
         for (int v = 0; v < 256; v++) {
-            lo_sum += count[v];
+            lo_sum += count(v);
             if (lo_sum >= total * HISTOGRAM_CLIP_THRESHOLD) {
                 lo = v;
                 break;
@@ -176,7 +209,7 @@ cv::Mat RectifyPolygonToRect(const cv::Mat &img, const ZXing::Barcode &bc, bool
         }
         int hi = 255, hi_sum = 0;
         for (int v = 255; v >= 0; v--) {
-            hi_sum += count[v];
+            hi_sum += count(v);
             if (hi_sum >= total * HISTOGRAM_CLIP_THRESHOLD) {
                 hi = v;
                 break;
@@ -184,33 +217,40 @@ cv::Mat RectifyPolygonToRect(const cv::Mat &img, const ZXing::Barcode &bc, bool
         }
         return {lo, hi};
     };
-    const auto [bLow, bHigh] = calc_lo_hi(bCount);
-    const auto [gLow, gHigh] = calc_lo_hi(gCount);
-    const auto [rLow, rHigh] = calc_lo_hi(rCount);
 
-    cv::Mat fimg;
-    rectifiedImage.convertTo(fimg, CV_32F);
-    {
-        std::vector<cv::Mat> channels(3);
-        cv::split(fimg, channels);
-        const auto norm_clip = [](cv::Mat &ch, int lo, int hi) {
-            ch = (ch - lo) / (hi - lo);
-            cv::min(ch, 1.0, ch);
-            cv::max(ch, 0.0, ch);
-        };
-        norm_clip(channels[0], bLow, bHigh);
-        norm_clip(channels[1], gLow, gHigh);
-        norm_clip(channels[2], rLow, rHigh);
-        cv::merge(channels, fimg);
+    // 拉伸到 [0, 1] 后做 3x^2 - 2x^3 映射，输出只取决于输入灰度级，因此每个通道折叠为 256 项的查找表。
+    // 查找表用原先逐像素的同一串浮点运算对 0-255 逐级求值，结果与逐像素计算一致
+    static const cv::Mat levels = [] {
+        cv::Mat m(1, 256, CV_32F);
+        for (int v = 0; v < 256; v++) {
+            m.at<float>(v) = static_cast<float>(v);
+        }
+        return m;
+    }();
+    const auto stretch = [&](cv::Mat &ch, int lo, int hi) {
+        ch.convertTo(ch, -1, 1.0 / (hi - lo), -static_cast<double>(lo) / (hi - lo));
+        cv::min(ch, 1.0, ch);
+        cv::max(ch, 0.0, ch);
+        cv::multiply(ch, ch, scratch.square);
+        ch.convertTo(scratch.factor, -1, -2.0, 3.0);
+        cv::multiply(scratch.square, scratch.factor, ch);
+    };
+
+    constexpr int kLevels = 256;
+    constexpr float kRange[] = {0, 256};
+    const float *ranges[] = {kRange};
+    scratch.tables.resize(cn);
+    for (int c = 0; c < cn; c++) {
+        cv::calcHist(&rectifiedImage, 1, &c, cv::noArray(), scratch.hist, 1, &kLevels, ranges);
+        const auto [lo, hi] = calc_lo_hi(scratch.hist);
+        levels.copyTo(scratch.curve);
+        stretch(scratch.curve, lo, hi);
+        scratch.curve.convertTo(scratch.tables[c], CV_8U, 255.0);
     }
+    cv::merge(scratch.tables, scratch.lut);
 
-    cv::Mat mat1;
-    cv::pow(fimg, 2, mat1);
-    cv::Mat mat2;
-    cv::pow(fimg, 3, mat2);
     cv::Mat enhanced;
-    cv::Mat(3 * mat1 - 2 * mat2).convertTo(enhanced, CV_8U, 255.0);
-
+    cv::LUT(rectifiedImage, scratch.lut, enhanced);
     return enhanced;
 }
 
@@ -221,6 +261,21 @@ CameraWidget::CameraWidget(QWidget *parent)
     setMinimumSize(800, 600);
     this->installEventFilter(this);
 
+    scanConfig = ScanConfig::load("./setting/config.json");
+    if (scanConfig.roiTracking) {
+        roiTracker = std::make_unique<RoiTracker>(scanConfig.fullScanInterval, scanConfig.roiPadding);
+    }
+    codeTracker = std::make_unique<CodeTracker>(std::chrono::milliseconds(scanConfig.trackTtlMs));
+    debugWriter = std::make_unique<DebugFrameWriter>(scanConfig.debugFrames);
+    detector = std::make_unique<CoarseToFineDetector>(scanConfig.coarseScales);
+    frameGate = std::make_unique<FrameGate>(scanConfig.gate);
+    metrics = std::make_unique<PipelineMetrics>();
+    lastMetrics = metrics->snapshot();
+    readerOptions.setTryHarder(scanConfig.tryHarder)
+        .setTryRotate(scanConfig.tryRotate)
+        .setTryDownscale(scanConfig.tryDownscale);
+    publishReaderOptions();
+
     mainLayout = new QVBoxLayout(this);
     menuBar = new QMenuBar(this);
 
@@ -277,7 +332,7 @@ CameraWidget::CameraWidget(QWidget *parent)
         isEnabledScan = false;
     });
 
-    // 更新 currentBarcodeFormat
+    // 选中的格式交给 ZXing，未选中的格式不会被尝试；全部未选中时停止识别
     auto updateMask = [this, formatActions] {
         bool anyChecked = false;
         ZXing::BarcodeFormat mask = ZXing::BarcodeFormat::None;
@@ -289,7 +344,8 @@ CameraWidget::CameraWidget(QWidget *parent)
             }
         }
 
-        currentBarcodeFormat = mask;
+        readerOptions.setFormats(mask);
+        publishReaderOptions();
         isEnabledScan = anyChecked;
     };
 
@@ -297,6 +353,28 @@ CameraWidget::CameraWidget(QWidget *parent)
         connect(act, &QAction::toggled, this, updateMask);
     }
 
+    // 识别选项：关闭后 ZXing 不再做对应的额外尝试，速度更快但可能漏识别
+    scanMenu->addSeparator();
+    const auto addReaderOption = [this, scanMenu](const QString &name, bool checked, auto apply) {
+        QAction *act = new QAction(name, this);
+        act->setCheckable(true);
+        act->setChecked(checked);
+        scanMenu->addAction(act);
+        connect(act, &QAction::toggled, this, [this, apply](bool on) {
+            apply(readerOptions, on);
+            publishReaderOptions();
+        });
+    };
+    addReaderOption("更彻底搜索 (tryHarder)", scanConfig.tryHarder, [](ZXing::ReaderOptions &o, bool on) {
+        o.setTryHarder(on);
+    });
+    addReaderOption("尝试旋转 (tryRotate)", scanConfig.tryRotate, [](ZXing::ReaderOptions &o, bool on) {
+        o.setTryRotate(on);
+    });
+    addReaderOption("尝试缩小 (tryDownscale)", scanConfig.tryDownscale, [](ZXing::ReaderOptions &o, bool on) {
+        o.setTryDownscale(on);
+    });
+
     const auto cameraDescriptions = CameraConfig::getCameraDescriptions();
     spdlog::info("Available cameras: {}", cameraDescriptions.size());
     for (int i = 0; i < cameraDescriptions.size(); ++i) {
@@ -311,6 +389,51 @@ CameraWidget::CameraWidget(QWidget *parent)
         });
     }
 
+    // 没有摄像头时也可以用视频文件、图片目录或录制的会话运行整条识别流水线
+    cameraMenu->addSeparator();
+    QAction *openVideoAction = new QAction("打开视频文件...", this);
+    QAction *openImagesAction = new QAction("打开图片目录...", this);
+    QAction *replayAction = new QAction("回放录制的会话...", this);
+    cameraMenu->addAction(openVideoAction);
+    cameraMenu->addAction(openImagesAction);
+    cameraMenu->addAction(replayAction);
+    connect(openVideoAction, &QAction::triggered, this, [this] {
+        const QString path = QFileDialog::getOpenFileName(
+            this, "选择视频文件", QString(), "视频文件 (*.mp4 *.avi *.mkv *.mov *.wmv);;所有文件 (*)");
+        if (!path.isEmpty()) {
+            switchSource([file = std::filesystem::path(path.toStdWString()), loop = scanConfig.loopPlayback] {
+                return std::make_unique<VideoFileSource>(file, loop);
+            });
+        }
+    });
+    connect(openImagesAction, &QAction::triggered, this, [this] {
+        const QString dir = QFileDialog::getExistingDirectory(this, "选择图片目录", "./debug_frames");
+        if (!dir.isEmpty()) {
+            switchSource([directory = std::filesystem::path(dir.toStdWString()),
+                          fps = scanConfig.imageSequenceFps,
+                          loop = scanConfig.loopPlayback] {
+                return std::make_unique<ImageDirectorySource>(directory, fps, loop);
+            });
+        }
+    });
+    connect(replayAction, &QAction::triggered, this, [this] {
+        const QString path = QFileDialog::getOpenFileName(this,
+                                                          "选择录制的会话",
+                                                          QString::fromStdString(scanConfig.recordingDirectory),
+                                                          "录制的会话 (*.mkv)");
+        if (!path.isEmpty()) {
+            switchSource([file = std::filesystem::path(path.toStdWString()), loop = scanConfig.loopPlayback] {
+                return std::make_unique<RecordedSessionSource>(file, loop);
+            });
+        }
+    });
+
+    cameraMenu->addSeparator();
+    recordAction = new QAction("录制会话", this);
+    recordAction->setCheckable(true);
+    cameraMenu->addAction(recordAction);
+    connect(recordAction, &QAction::toggled, this, &CameraWidget::setRecording);
+
     QMenu *postProcessingMenu = menuBar->addMenu("后处理");
 
     QAction *enhanceAction = new QAction("图像增强", this);
@@ -320,22 +443,56 @@ CameraWidget::CameraWidget(QWidget *parent)
 
     connect(enhanceAction, &QAction::toggled, this, [this](bool checked) { isEnhanceEnabled = checked; });
 
+    // 模糊或静止的帧不提交识别，预览不受影响
+    postProcessingMenu->addSeparator();
+    QAction *gateAction = new QAction("跳过模糊/静止帧", this);
+    gateAction->setCheckable(true);
+    gateAction->setChecked(frameGate->isEnabled());
+    postProcessingMenu->addAction(gateAction);
+    connect(gateAction, &QAction::toggled, this, [this](bool checked) { frameGate->setEnabled(checked); });
+
+    QAction *gateThresholdAction = new QAction("跳过门限...", this);
+    postProcessingMenu->addAction(gateThresholdAction);
+    connect(gateThresholdAction, &QAction::triggered, this, [this] {
+        const auto stats = frameGate->stats();
+        bool ok = false;
+        const double sharpness = QInputDialog::getDouble(
+            this, "跳过门限", "清晰度门限（拉普拉斯方差，低于该值视为模糊）:", stats.minSharpness, 0, 100000, 1, &ok);
+        if (!ok) {
+            return;
+        }
+        const double difference = QInputDialog::getDouble(
+            this, "跳过门限", "帧差门限（平均灰度差，低于该值视为静止）:", stats.minDifference, 0, 255, 2, &ok);
+        if (ok) {
+            frameGate->setThresholds(sharpness, difference);
+        }
+    });
+
+    QAction *statsAction = new QAction("显示统计信息", this);
+    statsAction->setCheckable(true);
+    statsAction->setChecked(isStatsOverlayEnabled);
+    postProcessingMenu->addAction(statsAction);
+    connect(statsAction, &QAction::toggled, this, [this](bool checked) {
+        isStatsOverlayEnabled = checked;
+        updateStatsOverlay();
+    });
+
+    QAction *metricsPanelAction = new QAction("流水线统计...", this);
+    postProcessingMenu->addAction(metricsPanelAction);
+    connect(metricsPanelAction, &QAction::triggered, this, &CameraWidget::showMetricsPanel);
+
+    postProcessingMenu->addSeparator();
+    QAction *benchmarkAction = new QAction("识别基准测试...", this);
+    postProcessingMenu->addAction(benchmarkAction);
+    connect(benchmarkAction, &QAction::triggered, this, &CameraWidget::runDetectorBenchmark);
+
     // FrameWidget: 可缩放
     frameWidget = new FrameWidget();
     frameWidget->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
     mainLayout->addWidget(frameWidget, 1);
 
     {
-        resultModel = new QStandardItemModel(0, 7, this); // 行，列
-        resultModel->setHorizontalHeaderLabels({
-            "时间",
-            "图像",
-            "类型",
-            "内容",
-            "[隐藏] PNG 数据",
-            "[隐藏] 图片宽度",
-            "[隐藏] 图片高度",
-        });
+        resultModel = new ScanResultModel(this);
 
         resultDisplay = new QTableView(this);
         resultDisplay->setModel(resultModel);
@@ -343,9 +500,9 @@ CameraWidget::CameraWidget(QWidget *parent)
         resultDisplay->setSelectionBehavior(QAbstractItemView::SelectRows);
         resultDisplay->setEditTriggers(QAbstractItemView::NoEditTriggers);
         resultDisplay->verticalHeader()->setVisible(false); // 隐藏行号
-        resultDisplay->setColumnHidden(4, true);            // 隐藏 PNG 数据列
-        resultDisplay->setColumnHidden(5, true);            // 隐藏 图片宽度 列
-        resultDisplay->setColumnHidden(6, true);            // 隐藏 图片高度 列
+        // 行高和图片列宽与缩略图一致
+        resultDisplay->verticalHeader()->setDefaultSectionSize(ScanResultModel::kThumbnailSize);
+        resultDisplay->setColumnWidth(ScanResultModel::ImageColumn, ScanResultModel::kThumbnailSize);
         // 或者使用比例方式
         resultDisplay->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Fixed);   // 时间固定
         resultDisplay->horizontalHeader()->setSectionResizeMode(1, QHeaderView::Fixed);   // 图像固定
@@ -373,6 +530,11 @@ CameraWidget::CameraWidget(QWidget *parent)
 
         mainLayout->addWidget(statusBar);
 
+        // 流水线指标每秒汇总一次
+        metricsTimer = new QTimer(this);
+        connect(metricsTimer, &QTimer::timeout, this, &CameraWidget::refreshMetrics);
+        metricsTimer->start(1000);
+
         // 初始化计时器
         barcodeClearTimer = new QTimer(this);
         barcodeClearTimer->setSingleShot(true);
@@ -446,7 +608,12 @@ void CameraWidget::hideEvent(QHideEvent *event) {
 
 void CameraWidget::showEvent(QShowEvent *event) {
     QWidget::showEvent(event); // 保留基类行为
-    if (!cameraStarted) {
+    if (cameraStarted) {
+        return;
+    }
+    if (openSource) {
+        startSource(); // 重新打开上次的帧来源
+    } else {
         startCamera(currentCameraIndex); // 使用当前摄像头索引
     }
 }
@@ -459,22 +626,11 @@ void CameraWidget::startCamera(int camIndex) {
         return;
     }
 
-    cameraStarted = true;
-    running = true;
-
-    asyncOpenFuture = std::async(std::launch::async, [this, camIndex] {
+    openSource = [this, camIndex]() -> std::unique_ptr<FrameSource> {
         spdlog::info("Opening VideoCapture index {}", camIndex);
-        auto cap = std::make_unique<cv::VideoCapture>(camIndex);
+        auto cap = std::make_unique<CameraSource>(camIndex);
         if (!cap->isOpened()) {
-            spdlog::error("Failed to open camera {}", camIndex);
-            QMetaObject::invokeMethod(
-                this,
-                [this] {
-                    QMessageBox::warning(this, "错误", "无法打开摄像头");
-                    cameraStarted = false;
-                },
-                Qt::QueuedConnection);
-            return;
+            return cap;
         }
         // 根据打开的摄像头加载摄像头配置
         std::vector<CameraConfig> configs = CameraConfig::getSupportedCameraConfigs(camIndex);
@@ -490,16 +646,90 @@ void CameraWidget::startCamera(int camIndex) {
                      config.pixelFormat.toStdString());
         //勾选对应的配置，在主线程操作 UI
         QMetaObject::invokeMethod(this, [this, config] { selectBestCameraConfigUI(config); }, Qt::QueuedConnection);
-        cap->set(cv::CAP_PROP_FRAME_WIDTH, config.width);
-        cap->set(cv::CAP_PROP_FRAME_HEIGHT, config.height);
-        cap->set(cv::CAP_PROP_FPS, config.fps);
+        cap->configure(config.width, config.height, config.fps);
+        return cap;
+    };
+    startSource();
+}
 
-        this->capture = cap.release();
+void CameraWidget::switchSource(std::function<std::unique_ptr<FrameSource>()> open) {
+    stopCamera();
+    openSource = std::move(open);
+    startSource();
+}
+
+void CameraWidget::startSource() {
+    if (cameraStarted || !openSource) {
+        return;
+    }
+
+    cameraStarted = true;
+    running = true;
+    const std::uint64_t generation = ++sourceGeneration;
+
+    // 后台线程只负责打开，打开的来源交回界面线程接管；期间已停止或切换到其它来源时直接丢弃
+    asyncOpenFuture = std::async(std::launch::async, [this, generation, open = openSource] {
+        // invokeMethod 要求可复制的函数对象，用 shared_ptr 把 unique_ptr 交给界面线程
+        auto opened = std::make_shared<std::unique_ptr<FrameSource>>(open());
+        const QString name = QString::fromStdString((*opened)->description());
+        if (!(*opened)->isOpened()) {
+            spdlog::error("Failed to open {}", (*opened)->description());
+            QMetaObject::invokeMethod(
+                this,
+                [this, name, generation] {
+                    if (generation != sourceGeneration) {
+                        return;
+                    }
+                    QMessageBox::warning(this, "错误", "无法打开" + name);
+                    cameraStarted = false;
+                },
+                Qt::QueuedConnection);
+            return;
+        }
 
         QMetaObject::invokeMethod(
             this,
-            [this] {
-                cameraStatusLabel->setText("摄像头已启动");
+            [this, name, generation, opened] {
+                if (generation != sourceGeneration || !running || !*opened) {
+                    return; // 已停止或重新启动，过期的来源随 opened 释放
+                }
+                source = std::move(*opened);
+                sourceName = name;
+                cameraStatusLabel->setText(sourceName + " 已启动");
+
+                // 按 CPU 核心数和实际的帧率、分辨率决定识别线程数
+                const cv::Size size = source->frameSize();
+                const int workers = DecodePool::suggestedWorkers(source->fps(), size.width, size.height);
+                spdlog::info("Decode pool started with {} workers", workers);
+                decodePool = std::make_unique<DecodePool>(
+                    workers,
+                    [this](const cv::Mat &frame, FrameResult &out) {
+                        const auto start = std::chrono::steady_clock::now();
+                        processFrame(frame, out);
+                        metrics->frameDecoded(std::chrono::steady_clock::now() - start);
+                    },
+                    [this](FrameResult &&result) {
+                        // 界面线程跟不上时只保留最新结果，同一时刻最多一个待处理的 updateFrame
+                        if (resultSlot.put(std::move(result), keepNewCodes)) {
+                            QMetaObject::invokeMethod(
+                                this,
+                                [this] {
+                                    if (auto latest = resultSlot.take()) {
+                                        updateFrame(*latest);
+                                    }
+                                },
+                                Qt::QueuedConnection);
+                        }
+                    });
+                // 同时在途的帧：识别队列和识别线程各 workers 帧，待显示的结果，正在读入的一帧，录制队列，
+                // 以及调试帧写盘队列（保存的是识别用的帧，亮度模式下来自亮度缓冲区池）
+                const std::size_t debugFrames = debugWriter->maxHeldFrames();
+                framePool = std::make_unique<FramePool>(2 * workers + 4 + SessionRecorder::kQueueSize + debugFrames);
+                if (scanConfig.lumaOnly) {
+                    lumaPool = std::make_unique<FramePool>(2 * workers + 4 + debugFrames);
+                }
+                // 预览图：正在显示、等待显示和正在生成的各一张
+                previewPool = std::make_unique<FramePool>(3);
                 captureThread = std::thread(&CameraWidget::captureLoop, this);
             },
             Qt::QueuedConnection);
@@ -511,101 +741,78 @@ void CameraWidget::stopCamera() {
     if (!cameraStarted) {
         return;
     }
+    ++sourceGeneration; // 尚未完成的异步打开不再启动采集
     running = false;
     if (captureThread.joinable()) {
         captureThread.join();
     }
-
-    if (capture) {
-        if (capture->isOpened()) {
-            capture->release();
-        }
-        delete capture;
+    decodePool.reset(); // 等待识别线程结束，未处理的帧直接丢弃
+    framePool.reset();
+    previewPool.reset();
+    lumaPool.reset();
+    if (roiTracker) {
+        roiTracker->reset();
     }
-    capture = nullptr;
+    codeTracker->reset();
+    frameGate->reset();
+    recordAction->setChecked(false); // 结束录制，下次启动的帧来源分辨率可能不同
+
+    source.reset();
     cameraStarted = false;
 
     cameraStatusLabel->setText("摄像头已停止");
 }
 
 void CameraWidget::updateFrame(const FrameResult &r) const {
-    // 显示视频帧
-    frameWidget->setFrame(r.frame);
+    metrics->resultShown(std::chrono::steady_clock::now() - r.timestamp);
+    PipelineMetrics::StageTimer timer(*metrics, PipelineStage::Ui);
 
-    cameraStatusLabel->setText("摄像头运行中...");
+    // 视频帧由采集线程直接送到预览，这里只更新条码轮廓
+    frameWidget->setOverlay(r.outlines);
 
-    if (r.hasBarcode) {
-        barcodeStatusLabel->setText("检测到 " + r.type + " 码");
-        barcodeStatusLabel->setStyleSheet("color: green; font-weight: bold;");
-
-        QString resultText = QString("条码类型: %1\n内容: %2\n时间: %3\n------------------------\n")
-                                 .arg(r.type)
-                                 .arg(r.content)
-                                 .arg(QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss"));
+    if (!r.hasBarcode) {
+        return;
+    }
+    barcodeStatusLabel->setText(r.codes.size() == 1 ? "检测到 " + r.codes.front().type + " 码"
+                                                    : QString("检测到 %1 个条码").arg(r.codes.size()));
+    barcodeStatusLabel->setStyleSheet("color: green; font-weight: bold;");
+    barcodeClearTimer->start(3000);
+
+    // 只处理新出现的条码，已在跟踪中的条码不再重复记录
+    const bool anyNew = std::ranges::any_of(r.codes, &ScannedCode::isNew);
+    if (!anyNew) {
+        return;
+    }
 
-        // 检查是否与上一条记录相同
-        static QString lastContent;
-        static QString lastType;
+    // 识别到新条码，保存整个视频帧用于调试；编码和写盘都在后台线程中进行
+    const bool saved = debugWriter->submit(r.frame, r.outlines, r.codes.front().type.toStdString());
 
-        if (r.content == lastContent && r.type == lastType) {
-            barcodeClearTimer->start(3000);
-            return;
+    for (const auto &code : r.codes) {
+        if (!code.isNew) {
+            continue;
         }
-        // 识别到条码，直接保存整个视频帧用于调试
+        spdlog::info("识别到条码 #{}: Type = {}, Content = {}{}",
+                     code.trackId,
+                     code.type.toStdString(),
+                     code.content.toStdString(),
+                     saved ? "（已提交调试帧）" : "");
+        addResultRow(code);
+    }
+}
 
-        if (!std::filesystem::exists("debug_frames")) {
-            std::filesystem::create_directory("debug_frames");
-        }
-        const std::string filename = std::format(
-            "./debug_frames/scan_{}_{}.png", r.type.toStdString(), sysinfo::getCurrentTimeString("%Y-%m-%d_%H-%M-%S"));
-        spdlog::info(
-            "识别到条码: Type = {}, Content = {} 保存到: {}", r.type.toStdString(), r.content.toStdString(), filename);
-        cv::imwrite(filename, r.frame);
-
-        // 更新上一次的记录
-        lastContent = r.content;
-        lastType = r.type;
-
-        QList<QStandardItem *> rowItems;
-        rowItems << new QStandardItem(QDateTime::currentDateTime().toString("hh:mm:ss"));
-        QStandardItem *imageItem = new QStandardItem();
-        if (r.rectifiedImage.empty()) {
-            // If the rectified image is empty, skip adding this result
-            return;
-        }
-        QImage img = QImage(static_cast<uchar *>(r.rectifiedImage.data),
-                            r.rectifiedImage.cols,
-                            r.rectifiedImage.rows,
-                            static_cast<int>(r.rectifiedImage.step),
-                            QImage::Format_RGB888)
-                         .rgbSwapped();
-        QPixmap pixmap = QPixmap::fromImage(img).scaled(128, 128, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-        imageItem->setData(pixmap, Qt::DecorationRole);
-        rowItems << imageItem;
-        rowItems << new QStandardItem(r.type);
-        rowItems << new QStandardItem(r.content);
-        // 存储 PNG 数据以便导出
-        QByteArray pngData;
-        QBuffer buffer(&pngData);
-        buffer.open(QIODevice::WriteOnly);
-        img.save(&buffer, "PNG");
-        buffer.close();
-        rowItems << new QStandardItem(QString::fromLatin1(pngData.toBase64()));
-        rowItems << new QStandardItem(QString::number(img.width()));  // 图片宽度
-        rowItems << new QStandardItem(QString::number(img.height())); // 图片高度
-
-        // 设置颜色
-        rowItems[2]->setForeground(Qt::blue);  // 类型蓝色
-        resultModel->insertRow(0, rowItems);   // 插入到顶部
-        resultDisplay->setRowHeight(0, 128);   // 设置行高
-        resultDisplay->setColumnWidth(1, 128); // 设置图片列宽度
-
-        // 限制行数
-        if (resultModel->rowCount() > 50) {
-            resultModel->removeRow(50);
-        }
-        barcodeClearTimer->start(3000);
+void CameraWidget::addResultRow(const ScannedCode &code) const {
+    if (code.rectifiedImage.empty() || code.png.isEmpty()) {
+        // If the rectified image is empty, skip adding this result
+        return;
     }
+    ScanResultModel::Entry entry;
+    entry.id = code.trackId;
+    entry.time = QDateTime::currentDateTime().toString("hh:mm:ss");
+    entry.type = code.type;
+    entry.content = code.content;
+    entry.png = code.png;
+    entry.imageSize = QSize(code.rectifiedImage.cols, code.rectifiedImage.rows);
+    resultModel->prepend(std::move(entry), code.rectifiedImage);
 }
 
 bool CameraWidget::exportResultsToHtml(const QString &filePath) {
@@ -625,9 +832,8 @@ bool CameraWidget::exportResultsToHtml(const QString &filePath) {
     // clang-format on
 
     for (int r = 0; r < resultModel->rowCount(); r++) {
-        const auto getText = [&](int c) -> QString {
-            QStandardItem *it = resultModel->item(r, c);
-            QString text = it ? it->text() : QString("");
+        const auto &entry = resultModel->entry(r);
+        const auto escape = [](QString text) -> QString {
             text.replace("&", "&amp;");
             text.replace("<", "&lt;");
             text.replace(">", "&gt;");
@@ -636,14 +842,16 @@ bool CameraWidget::exportResultsToHtml(const QString &filePath) {
             return text;
         };
         html += "<tr>";
-        html += "<td>" + getText(0) + "</td>";
+        html += "<td>" + escape(entry.time) + "</td>";
         html += "<td>";
-        if (QStandardItem *imgItem = resultModel->item(r, 4); imgItem) {
-            html += "<img src=\"data:image/png;base64," + imgItem->text() + "\" width=\"128\" />";
+        if (!entry.png.isEmpty()) {
+            // 只在导出时转为 Base64
+            const QString base64 = QString::fromLatin1(entry.png.toBase64());
+            html += "<img src=\"data:image/png;base64," + base64 + "\" width=\"128\" />";
         }
         html += "</td>";
-        html += "<td>" + getText(2) + "</td>";
-        html += "<td>" + getText(3) + "</td>";
+        html += "<td>" + escape(entry.type) + "</td>";
+        html += "<td>" + escape(entry.content) + "</td>";
         html += "</tr>";
     }
 
@@ -693,32 +901,25 @@ bool CameraWidget::exportResultsToXlsx(const QString &filePath) {
 
     for (int r = 0; r < resultModel->rowCount(); r++) {
         const int row = r + 1;
-        const auto getText = [&](int c) -> std::string {
-            QStandardItem *it = resultModel->item(r, c);
-            return it ? it->text().toStdString() : std::string();
-        };
+        const auto &entry = resultModel->entry(r);
 
         worksheet_set_row_pixels(worksheet, row, 150, NULL);
 
-        const auto t0 = getText(0);
-        const auto t1 = getText(2);
-        const auto t2 = getText(3);
+        const auto t0 = entry.time.toStdString();
+        const auto t1 = entry.type.toStdString();
+        const auto t2 = entry.content.toStdString();
 
         worksheet_write_string(worksheet, row, 0, t0.c_str(), NULL);
         worksheet_write_string(worksheet, row, 2, t1.c_str(), NULL);
         worksheet_write_string(worksheet, row, 3, t2.c_str(), NULL);
 
-        if (QStandardItem *imgItem = resultModel->item(r, 4); imgItem) {
-            QString base64Data = imgItem->text();
-            QByteArray ba = QByteArray::fromBase64(base64Data.toLatin1());
-            const int imgWidth = std::stoi(getText(5));
-            const int imgHeight = std::stoi(getText(6));
+        if (!entry.png.isEmpty() && !entry.imageSize.isEmpty()) {
             lxw_image_options options = {
-                .x_scale = 150.0 / imgWidth,
-                .y_scale = 150.0 / imgHeight,
+                .x_scale = 150.0 / entry.imageSize.width(),
+                .y_scale = 150.0 / entry.imageSize.height(),
             };
             worksheet_insert_image_buffer_opt(
-                worksheet, row, 1, (const unsigned char *)ba.constData(), ba.size(), &options);
+                worksheet, row, 1, (const unsigned char *)entry.png.constData(), entry.png.size(), &options);
         }
     }
 
@@ -729,51 +930,306 @@ bool CameraWidget::exportResultsToXlsx(const QString &filePath) {
 
 void CameraWidget::captureLoop() {
     spdlog::info("Capture thread started");
+    FramePacer pacer(source->fps());
+    const auto &allocations = MatAllocationCounter::install();
+    constexpr std::uint64_t kWarmupFrames = 100; // 预热期间缓冲区和各线程的临时图像陆续分配，不计入统计
+    std::uint64_t frames = 0;
+    std::uint64_t baseline = 0;
+    std::uint64_t previewsSkipped = 0;
     while (running) {
-        FrameResult result;
-        cv::Mat frame;
-        *capture >> frame;
-
-        if (frame.empty()) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        // 读入空闲的缓冲区，拷贝 Mat 头作为租约交给预览和识别线程，全部释放后缓冲区回到池中
+        cv::Mat &buffer = framePool->acquire();
+        pacer.waitForFrame();
+        const bool gotFrame = source->read(buffer);
+        pacer.frameReceived(gotFrame);
+        if (!gotFrame) {
+            if (source->finished()) {
+                spdlog::info("{} 播放完毕", source->description());
+                QMetaObject::invokeMethod(
+                    this, [this] { cameraStatusLabel->setText(sourceName + " 播放完毕"); }, Qt::QueuedConnection);
+                break;
+            }
             continue;
         }
+        cv::Mat frame = buffer;
+        const auto timestamp = std::chrono::steady_clock::now();
+        metrics->frameCaptured();
+        if (++frames == kWarmupFrames) {
+            baseline = allocations.count();
+        }
 
-        processFrame(frame, result);
-        result.frame = frame;
+        // 模糊或与上次识别的帧相比没有变化时不提交识别，预览和录制照常
+        const auto decision = [&] {
+            PipelineMetrics::StageTimer timer(*metrics, PipelineStage::Gate);
+            return frameGate->evaluate(frame, timestamp);
+        }();
+        if (decision == FrameGate::Decision::Decode) {
+            // 亮度模式：只提取一次亮度平面交给识别，彩色只用于显示尺寸的预览
+            cv::Mat decodeFrame = frame;
+            if (scanConfig.lumaOnly && frame.channels() != 1) {
+                PipelineMetrics::StageTimer timer(*metrics, PipelineStage::Luma);
+                cv::Mat &luma = lumaPool->acquire();
+                cv::cvtColor(frame, luma, frame.channels() == 4 ? cv::COLOR_BGRA2GRAY : cv::COLOR_BGR2GRAY);
+                decodeFrame = luma;
+            }
+            decodePool->submit(decodeFrame, timestamp);
+        }
+
+        std::shared_ptr<SessionRecorder> activeRecorder;
+        {
+            std::lock_guard lock(recorderMutex);
+            activeRecorder = recorder;
+        }
+        if (activeRecorder) {
+            activeRecorder->submit(frame, timestamp);
+        }
 
-        QMetaObject::invokeMethod(this, [this, result] { updateFrame(result); }, Qt::QueuedConnection);
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        // 预览在采集线程中缩放到显示尺寸，界面线程只拷贝像素；上一张还未显示时跳过本帧，不做无用的缩放
+        captureFps.store(pacer.measuredFps(), std::memory_order_relaxed);
+        if (previewSlot.isPending()) {
+            ++previewsSkipped;
+        } else if (previewSlot.put([&] {
+                       PipelineMetrics::StageTimer timer(*metrics, PipelineStage::Preview);
+                       return frameWidget->renderPreview(frame, previewPool->acquire());
+                   }())) {
+            QMetaObject::invokeMethod(
+                this,
+                [this] {
+                    if (auto latest = previewSlot.take()) {
+                        frameWidget->setPreview(std::move(*latest));
+                        const double fps = captureFps.load(std::memory_order_relaxed);
+                        cameraStatusLabel->setText(QString("%1 运行中... %2 FPS").arg(sourceName).arg(fps, 0, 'f', 1));
+                        updateStatsOverlay();
+                    }
+                },
+                Qt::QueuedConnection);
+        }
     }
-    spdlog::info("Capture thread stopped");
+    spdlog::info("Capture thread stopped, {} frames skipped by decoder, {} previews skipped, {} results coalesced",
+                 decodePool->droppedCount(),
+                 previewsSkipped + previewSlot.droppedCount(),
+                 resultSlot.droppedCount());
+    if (frames > kWarmupFrames) {
+        const auto steadyFrames = frames - kWarmupFrames;
+        spdlog::info("Steady state: {} cv::Mat allocations over {} frames ({:.2f} per frame), frame pool misses: {}",
+                     allocations.count() - baseline,
+                     steadyFrames,
+                     static_cast<double>(allocations.count() - baseline) / steadyFrames,
+                     framePool->missCount());
+    }
+}
+
+void CameraWidget::updateStatsOverlay() const {
+    if (!isStatsOverlayEnabled) {
+        frameWidget->setStatsText({});
+        return;
+    }
+    QStringList lines;
+    const auto gate = frameGate->stats();
+    if (frameGate->isEnabled()) {
+        lines << QString("清晰度 %1（门限 %2）").arg(gate.sharpness, 0, 'f', 1).arg(gate.minSharpness);
+        lines << QString("帧差 %1（门限 %2）").arg(gate.difference, 0, 'f', 2).arg(gate.minDifference);
+    }
+    lines << QString("识别 %1 / 模糊 %2 / 静止 %3").arg(gate.decoded).arg(gate.blurry).arg(gate.unchanged);
+    if (!metricsText.isEmpty()) {
+        lines << metricsText;
+    }
+    frameWidget->setStatsText(lines.join('\n'));
 }
 
-void CameraWidget::processFrame(cv::Mat &frame, FrameResult &out) const {
+void CameraWidget::refreshMetrics() {
+    const auto current = metrics->snapshot();
+    const auto report = PipelineMetrics::compare(lastMetrics, current);
+    lastMetrics = current;
+
+    if (!cameraStarted || !decodePool) {
+        metricsText.clear();
+    } else {
+        // 丢弃数从本次启动开始累计；队列深度为当前值，最大等于识别线程数
+        metricsText = report.toText();
+        metricsText += QString("\n识别队列 %1/%2，积压丢弃 %3 帧，合并结果 %4 个")
+                           .arg(decodePool->queueDepth())
+                           .arg(decodePool->workerCount())
+                           .arg(decodePool->droppedCount())
+                           .arg(resultSlot.droppedCount());
+    }
+    updateStatsOverlay();
+    if (metricsPanel && metricsPanel->isVisible()) {
+        metricsPanelLabel->setText(metricsText.isEmpty() ? "摄像头未运行" : metricsText);
+    }
+}
+
+void CameraWidget::showMetricsPanel() {
+    if (!metricsPanel) {
+        metricsPanel = new QDialog(this);
+        metricsPanel->setWindowTitle("流水线统计");
+        metricsPanelLabel = new QLabel(metricsPanel);
+        metricsPanelLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+        metricsPanelLabel->setAlignment(Qt::AlignLeft | Qt::AlignTop);
+        metricsPanelLabel->setMinimumWidth(320);
+        auto *layout = new QVBoxLayout(metricsPanel);
+        layout->addWidget(metricsPanelLabel);
+    }
+    metricsPanelLabel->setText(metricsText.isEmpty() ? "摄像头未运行" : metricsText);
+    metricsPanel->show();
+    metricsPanel->raise();
+}
+
+void CameraWidget::setRecording(bool enabled) {
+    std::shared_ptr<SessionRecorder> next;
+    if (enabled) {
+        next = std::make_shared<SessionRecorder>(scanConfig.recordingDirectory,
+                                                 captureFps.load(std::memory_order_relaxed));
+    }
+    std::shared_ptr<SessionRecorder> previous;
+    {
+        std::lock_guard lock(recorderMutex);
+        previous = std::exchange(recorder, std::move(next));
+    }
+    // 采集线程手里的引用释放后，录制器写完队列中剩余的帧再关闭文件
+    if (previous) {
+        cameraStatusLabel->setText("录制已保存到 " + QString::fromStdWString(previous->path().wstring()));
+    }
+}
+
+void CameraWidget::publishReaderOptions() {
+    auto snapshot = std::make_shared<const ZXing::ReaderOptions>(readerOptions);
+    std::lock_guard lock(readerOptionsMutex);
+    activeReaderOptions = std::move(snapshot);
+}
+
+void CameraWidget::processFrame(const cv::Mat &frame, FrameResult &out) const {
+    out.frame = frame;
     if (!isEnabledScan) {
         return;
     }
-    const auto barcodes = ZXing::ReadBarcodes(ImageViewFromMat(frame));
-    for (auto &bc : barcodes) {
-        if (!bc.isValid()) {
-            continue;
+
+    const auto detectStart = std::chrono::steady_clock::now();
+
+    // 整帧使用同一份识别参数，菜单修改只影响之后的帧
+    std::shared_ptr<const ZXing::ReaderOptions> options;
+    {
+        std::lock_guard lock(readerOptionsMutex);
+        options = activeReaderOptions;
+    }
+
+    // 识别到的条码及其在整帧中的位置
+    std::vector<CoarseToFineDetector::Detection> found;
+    const auto collect = [&](std::vector<CoarseToFineDetector::Detection> &&detections) {
+        int count = 0;
+        for (auto &detection : detections) {
+            const auto &bc = detection.barcode;
+
+            // 相邻的 ROI 可能重叠，同一位置的同一个条码只保留一次；不同位置的相同条码分别保留
+            const cv::Rect box = boundingBoxOf(detection.position);
+            if (std::ranges::any_of(found, [&](const auto &item) {
+                    return item.barcode.format() == bc.format() && item.barcode.text() == bc.text() &&
+                           (boundingBoxOf(item.position) & box).area() > 0;
+                })) {
+                continue;
+            }
+
+            found.push_back(std::move(detection));
+            ++count;
+        }
+        return count;
+    };
+
+    // 先只识别上次条码所在的区域；任一区域丢失目标（条码移动或离开）时本帧退回全帧识别
+    bool fullScan = true;
+    if (roiTracker) {
+        const auto plan = roiTracker->plan(frame.size());
+        fullScan = plan.fullScan;
+        for (const auto &roi : plan.rois) {
+            if (collect(CoarseToFineDetector::decode(frame(roi), roi.tl(), *options)) == 0) {
+                fullScan = true;
+                found.clear();
+                break;
+            }
         }
+    }
+    if (fullScan) {
+        collect(detector->detect(frame, *options));
+    }
+    if (roiTracker) {
+        std::vector<std::vector<cv::Point>> quads;
+        for (const auto &[bc, position] : found) {
+            quads.push_back({{position[0].x, position[0].y},
+                             {position[1].x, position[1].y},
+                             {position[2].x, position[2].y},
+                             {position[3].x, position[3].y}});
+        }
+        roiTracker->update(out.timestamp, fullScan, quads);
+    }
+
+    metrics->addStageTime(PipelineStage::Detect, std::chrono::steady_clock::now() - detectStart);
 
-        // 如果 currentBarcodeFormat = None -> 全部模式
-        if (currentBarcodeFormat != ZXing::BarcodeFormat::None &&
-            !(static_cast<int>(bc.format()) & static_cast<int>(currentBarcodeFormat))) {
-            continue; // 当前格式未被选中，跳过
+    // 按（格式，内容，位置）跟踪，只有新出现的条码才矫正，避免同一个条码每帧重复处理
+    std::vector<CodeTracker::Observation> observations;
+    for (const auto &[bc, position] : found) {
+        const cv::Rect box = boundingBoxOf(position);
+        observations.push_back({static_cast<int>(bc.format()), bc.text(), (box.tl() + box.br()) * 0.5});
+    }
+    const auto matches = codeTracker->update(observations, out.timestamp);
+
+    for (std::size_t i = 0; i < found.size(); ++i) {
+        const auto &[bc, position] = found[i];
+        ScannedCode code;
+        code.trackId = matches[i].id;
+        code.isNew = matches[i].isNew;
+        code.type = QString::fromStdString(ZXing::ToString(bc.format()));
+        code.content = QString::fromStdString(bc.text());
+        if (code.isNew) {
+            PipelineMetrics::StageTimer timer(*metrics, PipelineStage::Rectify);
+            code.rectifiedImage = RectifyPolygonToRect(frame, position, isEnhanceEnabled);
+            // PNG 编码也在识别线程中完成，界面线程只保存二进制数据
+            std::vector<uchar> png;
+            if (cv::imencode(".png", code.rectifiedImage, png)) {
+                code.png = QByteArray(reinterpret_cast<const char *>(png.data()), static_cast<int>(png.size()));
+            }
         }
 
-        out.hasBarcode = true;
-        out.type = QString::fromStdString(ZXing::ToString(bc.format()));
-        out.content = QString::fromStdString(bc.text());
-        out.rectifiedImage = RectifyPolygonToRect(frame, bc, isEnhanceEnabled);
-        DrawBarcode(frame, bc);
+        QPolygon polygon;
+        for (const auto &p : position) {
+            polygon << QPoint(p.x, p.y);
+        }
+        out.outlines.push_back({polygon, code.content});
+        out.codes.push_back(std::move(code));
+    }
+    out.hasBarcode = !out.codes.empty();
+}
+
+void CameraWidget::runDetectorBenchmark() {
+    // 调试保存的帧叠加了识别框、只保留识别到新条码的帧，会高估识别率，因此只接受录制的原始会话
+    const QString path = QFileDialog::getOpenFileName(this,
+                                                      "选择录制的会话",
+                                                      QString::fromStdString(scanConfig.recordingDirectory),
+                                                      "录制的会话 (*.mkv)");
+    if (path.isEmpty()) {
+        return;
     }
+
+    // 以原分辨率整帧识别为基准，与常用倍数和当前配置比较
+    std::vector<std::vector<int>> configs = {{1}, {2}, {4}, {4, 2, 1}};
+    if (std::ranges::find(configs, scanConfig.coarseScales) == configs.end()) {
+        configs.push_back(scanConfig.coarseScales);
+    }
+
+    cameraStatusLabel->setText(QString("正在测试 %1...").arg(QFileInfo(path).fileName()));
+    auto *watcher = new QFutureWatcher<std::vector<DetectorBenchmark::Row>>(this);
+    connect(watcher, &QFutureWatcher<std::vector<DetectorBenchmark::Row>>::finished, this, [this, watcher] {
+        watcher->deleteLater();
+        cameraStatusLabel->setText("识别基准测试完成");
+        const QString report = DetectorBenchmark::toText(watcher->result());
+        spdlog::info("识别基准测试:\n{}", report.toStdString());
+        QMessageBox::information(this, "识别基准测试", report);
+    });
+    watcher->setFuture(QtConcurrent::run(
+        DetectorBenchmark::run, std::filesystem::path(path.toStdWString()), configs, scanConfig.lumaOnly));
 }
 
 void CameraWidget::onCameraConfigSelected(CameraConfig config) {
-    if (!capture) {
+    if (!source) {
         spdlog::error("Failed to open camera {}", currentCameraIndex);
         return;
     }
@@ -783,18 +1239,10 @@ void CameraWidget::onCameraConfigSelected(CameraConfig config) {
                  config.fps,
                  config.pixelFormat.toStdString());
 
-    bool okWidth = capture->set(cv::CAP_PROP_FRAME_WIDTH, config.width);
-    bool okHeight = capture->set(cv::CAP_PROP_FRAME_HEIGHT, config.height);
-    bool okFps = capture->set(cv::CAP_PROP_FPS, config.fps);
-
-    spdlog::info("Set width={}, ok={}", config.width, okWidth);
-    spdlog::info("Set height={}, ok={}", config.height, okHeight);
-    spdlog::info("Set fps={}, ok={}", config.fps, okFps);
+    source->configure(config.width, config.height, config.fps);
 
-    double actual_width = capture->get(cv::CAP_PROP_FRAME_WIDTH);
-    double actual_height = capture->get(cv::CAP_PROP_FRAME_HEIGHT);
-    double actual_fps = capture->get(cv::CAP_PROP_FPS);
-    spdlog::info("Actual Camera Config - Resolution: {}x{}, FPS: {}", actual_width, actual_height, actual_fps);
+    const cv::Size actual = source->frameSize();
+    spdlog::info("Actual Camera Config - Resolution: {}x{}, FPS: {}", actual.width, actual.height, source->fps());
 }
 
 void CameraWidget::loadCameraConfigs(const std::vector<CameraConfig> &configs) {
@@ -3,6 +3,17 @@
 
 #include "CameraConfig.h"
 #include "FrameWidget.h"
+#include "camera/CoalescingSlot.h"
+#include "camera/CoarseToFineDetector.h"
+#include "camera/CodeTracker.h"
+#include "camera/DebugFrameWriter.h"
+#include "camera/DecodePool.h"
+#include "camera/FrameGate.h"
+#include "camera/FramePool.h"
+#include "camera/FrameSource.h"
+#include "camera/PipelineMetrics.h"
+#include "camera/RoiTracker.h"
+#include "camera/ScanConfig.h"
 #include "commondef.h"
 #include <QStatusBar>
 #include <QTextEdit>
@@ -10,7 +21,11 @@
 #include <QWidget>
 #include <ZXing/BarcodeFormat.h>
 #include <atomic>
+#include <cstdint>
+#include <functional>
 #include <future>
+#include <memory>
+#include <mutex>
 #include <opencv2/opencv.hpp>
 #include <qactiongroup.h>
 #include <qcombobox.h>
@@ -21,8 +36,10 @@ class QPushButton;
 class QMenuBar;
 class QLabel;
 class QTimer;
+class QDialog;
 class QTableView;
-class QStandardItemModel;
+class ScanResultModel;
+class SessionRecorder;
 
 /**
  * @class CameraWidget
@@ -58,6 +75,12 @@ public:
      */
     void stopCamera();
 
+    /**
+     * @brief 停止当前帧来源并切换到新的帧来源（视频文件、图片目录、录制的会话等）
+     * @param open 打开帧来源，在后台线程中调用；窗口重新显示时会再次调用
+     */
+    void switchSource(std::function<std::unique_ptr<FrameSource>()> open);
+
 protected:
     /**
      * @brief 事件过滤器函数
@@ -94,13 +117,45 @@ private:
     void onCameraIndexChanged(int index);
 
     /**
-     * @brief 更新视频帧显示
+     * @brief 用 openSource 打开帧来源并启动识别池和采集线程
+     */
+    void startSource();
+
+    /**
+     * @brief 开始或结束会话录制
+     * @param enabled 是否录制；结束时录制器写完剩余的帧后关闭文件
+     */
+    void setRecording(bool enabled);
+
+    /**
+     * @brief 刷新预览左上角的统计信息，随预览帧一起更新
+     */
+    void updateStatsOverlay() const;
+
+    /**
+     * @brief 每秒计算一次流水线指标，刷新叠加层和统计面板
+     */
+    void refreshMetrics();
+
+    /**
+     * @brief 显示流水线统计面板（非模态）
+     */
+    void showMetricsPanel();
+
+    /**
+     * @brief 处理一帧的条码识别结果
      * 
-     * 在UI线程中更新视频帧显示，并处理条码识别结果
+     * 在UI线程中更新预览叠加层，并记录新出现的条码；视频帧本身由采集线程直接送到预览
      * @param r 视频帧处理结果
      */
     void updateFrame(const FrameResult &r) const;
 
+    /**
+     * @brief 把一个新出现的条码插入结果表格顶部
+     * @param code 识别到的条码，须带有矫正后的图片及其 PNG 编码
+     */
+    void addResultRow(const ScannedCode &code) const;
+
     /**
      * @brief 导出扫描结果为 HTML 文件
      */
@@ -113,18 +168,31 @@ private:
     /**
      * @brief 摄像头捕获循环函数
      * 
-     * 在独立线程中持续捕获摄像头视频帧并进行处理
+     * 在独立线程中持续捕获摄像头视频帧，只负责送去预览和提交到识别池，不做识别，
+     * 因此预览帧率等于摄像头帧率，驱动内部也不会积压旧帧
      */
     void captureLoop();
 
     /**
      * @brief 处理视频帧中的条码识别
      * 
-     * 对输入的视频帧进行条码识别，并在找到条码时进行标记
-     * @param frame 输入的视频帧（会被修改以绘制条码标记）
+     * 对输入的视频帧进行条码识别；找到条码时输出轮廓，并在帧的副本上绘制标记用于调试保存
+     * @param frame 输入的视频帧（不会被修改，预览可能仍在使用）
      * @param out 识别结果输出参数
      */
-    void processFrame(cv::Mat &frame, FrameResult &out) const;
+    void processFrame(const cv::Mat &frame, FrameResult &out) const;
+
+    /**
+     * @brief 把界面上编辑的识别参数发布给识别线程，从下一帧开始生效
+     */
+    void publishReaderOptions();
+
+    /**
+     * @brief 用录制的会话比较不同缩小倍数下的识别耗时和识别率
+     *
+     * 选择会话录制目录中的视频，按当前的亮度模式设置在后台线程中测试，完成后显示报告
+     */
+    void runDetectorBenchmark();
 
     /**
      * @brief 摄像头配置切换处理函数
@@ -151,16 +219,23 @@ private:
     void selectBestCameraConfigUI(const CameraConfig &bestConfig) const;
 
 private:
-    cv::VideoCapture *capture = nullptr;       /**< 摄像头捕获对象，用于获取视频帧 */
+    std::unique_ptr<FrameSource> source;       /**< 帧来源，只在采集线程中读帧 */
     std::atomic_bool running{false};           /**< 控制摄像头捕获循环是否运行的原子布尔值 */
     std::thread captureThread;                 /**< 摄像头捕获线程对象 */
+    std::unique_ptr<DecodePool> decodePool;    /**< 条码识别线程池 */
+    std::unique_ptr<FramePool> framePool;      /**< 复用的视频帧缓冲区 */
+    std::unique_ptr<FramePool> lumaPool;       /**< 复用的亮度平面缓冲区，亮度模式下使用 */
+    ScanConfig scanConfig;                     /**< 连续扫描参数 */
+    std::unique_ptr<RoiTracker> roiTracker;    /**< ROI 跟踪，未启用时为空 */
+    std::unique_ptr<CodeTracker> codeTracker;  /**< 多条码跟踪，为条码分配稳定编号 */
     std::future<void> asyncOpenFuture;         /**< 异步打开摄像头的 future 对象 */
     bool cameraStarted = false;                /**< 标记摄像头是否已经启动 */
+    std::uint64_t sourceGeneration = 0;        /**< 每次启动、停止帧来源时递增，用于丢弃过期的异步打开结果 */
     std::atomic_bool isEnabledScan = true;     /**< 控制是否启用条码扫描功能的原子布尔值 */
     QVBoxLayout *mainLayout = nullptr;         /**< 主布局管理器 */
     FrameWidget *frameWidget = nullptr;        /**< 视频帧显示组件 */
     QTableView *resultDisplay;                 /**< 结果显示表格视图 */
-    QStandardItemModel *resultModel;           /**< 结果显示表格的数据模型 */
+    ScanResultModel *resultModel;              /**< 结果显示表格的数据模型 */
     QStatusBar *statusBar = nullptr;           /**< 状态栏组件 */
     QMenuBar *menuBar;                         /**< 菜单栏组件 */
     QMenu *cameraMenu;                         /**< 摄像头选择菜单 */
@@ -168,11 +243,32 @@ private:
     QActionGroup *cameraActionGroup = nullptr; /**< 摄像头配置ActionGroup */
     int currentCameraIndex = 0;                /**< 当前选择的摄像头索引 */
     QComboBox *barcodeTypeCombo = nullptr;     /**< 条码类型选择组合框 */
-    ZXing::BarcodeFormat currentBarcodeFormat = ZXing::BarcodeFormat::None; /**< 当前选择的条码格式 */
+    ZXing::ReaderOptions readerOptions;                                     /**< 识别参数界面线程编辑 */
+    mutable std::mutex readerOptionsMutex;                                  /**< 保护 activeReaderOptions */
+    std::shared_ptr<const ZXing::ReaderOptions> activeReaderOptions;        /**< 识别线程使用的识别参数快照 */
     QLabel *cameraStatusLabel;                                              /**< 摄像头状态标签 */
     QLabel *barcodeStatusLabel;                                             /**< 条码识别状态标签 */
     QTimer *barcodeClearTimer;                                              /**< 条码状态清除定时器 */
     bool isEnhanceEnabled = true;                                           /**< 是否启用图像增强 */
+    bool isStatsOverlayEnabled = false;                                     /**< 是否在预览上显示统计信息 */
+    std::unique_ptr<FrameGate> frameGate;                                   /**< 跳过模糊或静止的帧 */
+    std::unique_ptr<PipelineMetrics> metrics;                               /**< 流水线性能指标，各线程无锁记录 */
+    PipelineMetrics::Snapshot lastMetrics;                                  /**< 上次刷新时的指标快照 */
+    QString metricsText;                                                    /**< 最近一秒的指标文本 */
+    QTimer *metricsTimer = nullptr;                                         /**< 指标刷新定时器 */
+    QDialog *metricsPanel = nullptr;                                        /**< 流水线统计面板 */
+    QLabel *metricsPanelLabel = nullptr;                                    /**< 统计面板中的文本 */
+    std::unique_ptr<CoarseToFineDetector> detector;                         /**< 全帧识别：缩小定位、原分辨率识别 */
+    CoalescingSlot<FrameWidget::Preview> previewSlot;                       /**< 待显示的最新预览图 */
+    std::unique_ptr<FramePool> previewPool;                                 /**< 复用的预览图缓冲区 */
+    CoalescingSlot<FrameResult> resultSlot;                                 /**< 待显示的最新识别结果 */
+    std::atomic<double> captureFps{0.0};                                    /**< 采集线程实测帧率 */
+    std::unique_ptr<DebugFrameWriter> debugWriter;                          /**< 后台保存调试帧 */
+    std::function<std::unique_ptr<FrameSource>()> openSource;               /**< 打开当前帧来源，为空时使用摄像头 */
+    QString sourceName;                                                     /**< 当前帧来源的描述 */
+    QAction *recordAction = nullptr;                                        /**< 会话录制开关 */
+    mutable std::mutex recorderMutex;                                       /**< 保护 recorder */
+    std::shared_ptr<SessionRecorder> recorder;                              /**< 会话录制，未录制时为空 */
 };
 
 #endif // CAMERAWIDGET_H
\ No newline at end of file
@@ -1,7 +1,11 @@
 #include "FrameWidget.h"
 #include <QImage>
 #include <QPainter>
+#include <QPen>
+#include <QResizeEvent>
 #include <QStyleOption>
+#include <QTransform>
+#include <opencv2/imgproc.hpp>
 #include <spdlog/spdlog.h>
 namespace {
 
@@ -28,6 +32,11 @@ QRect scaleKeepAspect(const QRect &outer, const int w, const int h) {
     return QRect(outer.x() + (outerW - newW) / 2, outer.y() + (outerH - newH) / 2, newW, newH);
 }
 
+// QImage 释放时归还缓冲区的引用
+void releaseMat(void *mat) {
+    delete static_cast<cv::Mat *>(mat);
+}
+
 } // namespace
 
 FrameWidget::FrameWidget(QWidget *parent)
@@ -35,24 +44,61 @@ FrameWidget::FrameWidget(QWidget *parent)
     setStyleSheet("QWidget{border:1px solid black; background-color:black;}");
 }
 
-void FrameWidget::setFrame(const cv::Mat &bgr) {
-    if (bgr.empty() || bgr.type() != CV_8UC3) {
-        spdlog::warn("PlayerWidget::setFrame received invalid mat");
-        return;
+FrameWidget::Preview FrameWidget::renderPreview(const cv::Mat &frame, cv::Mat &buffer) const {
+    if (frame.empty() || frame.depth() != CV_8U) {
+        spdlog::warn("FrameWidget::renderPreview received invalid mat");
+        return {};
     }
 
-    // 创建 RGB QImage 然后交换 R 和 B 通道
-    m_image = QImage(bgr.data,
-                     bgr.cols,
-                     bgr.rows,
-                     static_cast<int>(bgr.step),
-                     QImage::Format_RGB888)
-                  .rgbSwapped()
-                  .copy(); // 先交换通道再深拷贝
+    const QRect view(0, 0, m_viewWidth.load(std::memory_order_relaxed), m_viewHeight.load(std::memory_order_relaxed));
+    QSize size = scaleKeepAspect(view, frame.cols, frame.rows).size();
+    if (size.isEmpty() || size.width() > frame.cols) {
+        size = QSize(frame.cols, frame.rows); // 窗口尚未显示或比帧大时不放大，绘制时再缩放
+    }
 
+    // 先缩小再转换颜色，颜色转换只处理显示尺寸的像素
+    thread_local cv::Mat scaled;
+    const cv::Mat *source = &frame;
+    if (size.width() != frame.cols || size.height() != frame.rows) {
+        cv::resize(frame, scaled, cv::Size(size.width(), size.height()), 0, 0, cv::INTER_AREA);
+        source = &scaled;
+    }
+    switch (source->channels()) {
+    case 1: cv::cvtColor(*source, buffer, cv::COLOR_GRAY2RGB); break;
+    case 3: cv::cvtColor(*source, buffer, cv::COLOR_BGR2RGB); break;
+    case 4: cv::cvtColor(*source, buffer, cv::COLOR_BGRA2RGB); break;
+    default: spdlog::warn("FrameWidget::renderPreview received invalid mat"); return {};
+    }
+
+    QImage image(buffer.data,
+                 buffer.cols,
+                 buffer.rows,
+                 static_cast<int>(buffer.step),
+                 QImage::Format_RGB888,
+                 releaseMat,
+                 new cv::Mat(buffer));
+    return {image, QSize(frame.cols, frame.rows)};
+}
+
+void FrameWidget::setPreview(Preview preview) {
+    m_image = std::move(preview.image);
+    m_image.setDevicePixelRatio(devicePixelRatioF()); // renderPreview 按物理像素生成
+    m_frameSize = preview.frameSize;
     update(); // 触发 Qt 重绘
 }
 
+void FrameWidget::setOverlay(std::vector<BarcodeOutline> outlines) {
+    m_outlines = std::move(outlines);
+    update();
+}
+
+void FrameWidget::setStatsText(const QString &text) {
+    if (text != m_statsText) {
+        m_statsText = text;
+        update();
+    }
+}
+
 void FrameWidget::paintEvent(QPaintEvent *event) {
     Q_UNUSED(event);
 
@@ -65,17 +111,54 @@ void FrameWidget::paintEvent(QPaintEvent *event) {
     style()->drawPrimitive(QStyle::PE_Widget, &opt, &painter, this);
 
     // 没有图像直接返回
-    if (m_image.isNull()) {
+    if (m_image.isNull() || m_frameSize.isEmpty()) {
         return;
     }
 
-    // 自动等比缩放并居中
-    const QRect dst = scaleKeepAspect(rect(), m_image.width(), m_image.height());
+    // 自动等比缩放并居中；预览图已按显示尺寸生成时直接拷贝像素，窗口刚改变大小时才临时缩放
+    const QRect dst = scaleKeepAspect(rect(), m_frameSize.width(), m_frameSize.height());
+    if (m_image.size() == dst.size() * devicePixelRatioF()) {
+        painter.drawImage(dst.topLeft(), m_image);
+    } else {
+        painter.drawImage(dst, m_image);
+    }
+
+    // 条码轮廓：帧像素坐标映射到显示区域，文字不随画面缩放
+    if (!m_outlines.empty()) {
+        QTransform toView;
+        toView.translate(dst.x(), dst.y());
+        toView.scale(static_cast<qreal>(dst.width()) / m_frameSize.width(),
+                     static_cast<qreal>(dst.height()) / m_frameSize.height());
+        painter.setPen(QPen(QColor(0, 255, 0), 2));
+        for (const auto &outline : m_outlines) {
+            const QPolygon polygon = toView.map(outline.polygon);
+            painter.drawPolygon(polygon);
+            if (polygon.size() == 4) {
+                painter.drawText(polygon[3] + QPoint(0, 20), outline.text);
+            }
+        }
+    }
+
+    // 统计信息：半透明底色上的白字，固定在画面左上角
+    if (!m_statsText.isEmpty()) {
+        constexpr int flags = Qt::AlignLeft | Qt::AlignTop;
+        const QRect textRect = painter.fontMetrics().boundingRect(rect(), flags, m_statsText);
+        const QRect box = textRect.translated(dst.topLeft() + QPoint(8, 8)).adjusted(-4, -4, 4, 4);
+        painter.fillRect(box, QColor(0, 0, 0, 160));
+        painter.setPen(Qt::white);
+        painter.drawText(box.adjusted(4, 4, -4, -4), flags, m_statsText);
+    }
+}
 
-    painter.drawImage(dst, m_image);
+void FrameWidget::resizeEvent(QResizeEvent *event) {
+    QWidget::resizeEvent(event);
+    m_viewWidth.store(static_cast<int>(width() * devicePixelRatioF()), std::memory_order_relaxed);
+    m_viewHeight.store(static_cast<int>(height() * devicePixelRatioF()), std::memory_order_relaxed);
 }
 
 void FrameWidget::clear() {
-    m_image = QImage(); // 清空图像
-    update();           // 触发重绘
+    m_image = QImage();    // 清空图像
+    m_frameSize = QSize(); // 清空帧尺寸
+    m_outlines.clear();    // 清空叠加层
+    update();              // 触发重绘
 }
\ No newline at end of file
@@ -1,6 +1,10 @@
 #pragma once
+#include "commondef.h"
+#include <QImage>
 #include <QWidget>
+#include <atomic>
 #include <opencv2/core.hpp>
+#include <vector>
 
 /**
  * @class FrameWidget
@@ -9,14 +13,44 @@
 class FrameWidget : public QWidget {
     Q_OBJECT
 public:
+    /**
+     * @brief 已缩放到显示尺寸的预览图
+     */
+    struct Preview {
+        QImage image;    // 显示尺寸的 RGB 图像，像素由 renderPreview 的缓冲区持有
+        QSize frameSize; // 原始帧尺寸，用于映射条码轮廓坐标
+    };
+
     explicit FrameWidget(QWidget *parent = nullptr);
 
     /**
-     * @brief 设置要显示的图像帧
+     * @brief 把帧缩放到当前显示尺寸并转换为 RGB，可在任意线程调用
+     *  缩放和颜色转换都在调用线程完成，界面线程绘制时只需直接拷贝像素；
+     *  返回的图像直接引用 buffer 的像素并持有它的引用计数，显示期间 buffer 不会被复用
+     * @param frame 输入的 BGR、BGRA 或灰度图像
+     * @param buffer 输出缓冲区（通常来自 FramePool），尺寸不变时不再分配
+     */
+    Preview renderPreview(const cv::Mat &frame, cv::Mat &buffer) const;
+
+    /**
+     * @brief 设置要显示的预览图
      *  会自动触发重绘事件
-     * @param bgr 输入的 BGR 格式图像
+     * @param preview renderPreview 的结果
      */
-    void setFrame(const cv::Mat &bgr);
+    void setPreview(Preview preview);
+
+    /**
+     * @brief 设置叠加显示的条码轮廓
+     *  轮廓来自识别线程，坐标为帧像素坐标，绘制时随画面一起缩放；不修改帧本身
+     * @param outlines 条码轮廓，为空时清除叠加层
+     */
+    void setOverlay(std::vector<BarcodeOutline> outlines);
+
+    /**
+     * @brief 设置左上角叠加显示的统计信息
+     * @param text 多行文本，为空时不显示
+     */
+    void setStatsText(const QString &text);
 
     void clear();
 
@@ -28,6 +62,16 @@ protected:
      */
     void paintEvent(QPaintEvent *event) override;
 
+    /**
+     * @brief 记录显示尺寸，供其他线程中的 renderPreview 使用
+     */
+    void resizeEvent(QResizeEvent *event) override;
+
 private:
-    QImage m_image; // 转换后的图像
+    QImage m_image;                         // 显示尺寸的预览图
+    QSize m_frameSize;                      // 预览图对应的原始帧尺寸
+    std::vector<BarcodeOutline> m_outlines; // 叠加显示的条码轮廓
+    QString m_statsText;                    // 叠加显示的统计信息
+    std::atomic<int> m_viewWidth{0};        // 显示区域宽度（物理像素）
+    std::atomic<int> m_viewHeight{0};       // 显示区域高度（物理像素）
 };
\ No newline at end of file
@@ -0,0 +1,297 @@
+#include "ArchiveReader.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <zlib.h>
+
+namespace {
+
+constexpr quint32 kZipLocalHeader = 0x04034b50;
+constexpr quint32 kZipCentralHeader = 0x02014b50;
+constexpr quint32 kZipEndOfCentral = 0x06054b50;
+constexpr quint32 kZip64EndOfCentral = 0x06064b50;
+constexpr quint32 kZip64Locator = 0x07064b50;
+constexpr quint32 kMax32 = std::numeric_limits<quint32>::max();
+constexpr quint16 kMax16 = std::numeric_limits<quint16>::max();
+constexpr quint64 kTarBlock = 512;
+
+quint16 getU16(const uchar *p) {
+    return static_cast<quint16>(p[0] | (p[1] << 8));
+}
+
+quint32 getU32(const uchar *p) {
+    return getU16(p) | (static_cast<quint32>(getU16(p + 2)) << 16);
+}
+
+quint64 getU64(const uchar *p) {
+    return getU32(p) | (static_cast<quint64>(getU32(p + 4)) << 32);
+}
+
+/**
+ * @brief 解析 TAR 头部的八进制数字段
+ */
+quint64 parseOctal(const uchar *field, int width) {
+    quint64 value = 0;
+    for (int i = 0; i < width && field[i]; ++i) {
+        if (field[i] >= '0' && field[i] <= '7') {
+            value = value * 8 + (field[i] - '0');
+        }
+    }
+    return value;
+}
+
+/**
+ * @brief 读取以 NUL 结尾（或占满字段）的字符串字段
+ */
+QByteArray cString(const uchar *field, int width) {
+    const auto *begin = reinterpret_cast<const char *>(field);
+    return QByteArray(begin, static_cast<int>(strnlen(begin, static_cast<size_t>(width))));
+}
+
+/**
+ * @brief 从 pax 扩展头中取出 path 记录（格式为 "长度 key=value\n"）
+ */
+QByteArray paxPath(const QByteArray &records) {
+    int pos = 0;
+    while (pos < records.size()) {
+        const int space = records.indexOf(' ', pos);
+        if (space < 0) {
+            break;
+        }
+        const int len = records.mid(pos, space - pos).toInt();
+        if (len <= 0 || pos + len > records.size()) {
+            break;
+        }
+        const QByteArray record = records.mid(space + 1, pos + len - space - 2);
+        if (record.startsWith("path=")) {
+            return record.mid(5);
+        }
+        pos += len;
+    }
+    return {};
+}
+
+} // namespace
+
+ArchiveReader::ArchiveReader(const QString &path)
+    : file(path) {
+    if (!file.open(QIODevice::ReadOnly)) {
+        error = file.errorString();
+        return;
+    }
+    length = static_cast<quint64>(file.size());
+    data = length > 0 ? file.map(0, file.size()) : nullptr;
+    if (!data) {
+        error = length > 0 ? file.errorString() : QString("空文件");
+        return;
+    }
+
+    if (length >= 4 && (getU32(data) == kZipLocalHeader || getU32(data) == kZipEndOfCentral)) {
+        parseZip();
+    } else if (length >= kTarBlock && memcmp(data + 257, "ustar", 5) == 0) {
+        parseTar();
+    } else {
+        error = "不支持的压缩包格式（仅支持 ZIP / TAR）";
+    }
+    if (!error.isEmpty()) {
+        items.clear();
+    }
+}
+
+bool ArchiveReader::isOpen() const {
+    return data && error.isEmpty();
+}
+
+QString ArchiveReader::errorString() const {
+    return error;
+}
+
+QString ArchiveReader::path() const {
+    return file.fileName();
+}
+
+const std::vector<ArchiveReader::Entry> &ArchiveReader::entries() const {
+    return items;
+}
+
+QByteArray ArchiveReader::read(int index) const {
+    if (!isOpen() || index < 0 || index >= static_cast<int>(items.size())) {
+        return {};
+    }
+    const Entry &entry = items[index];
+    if (entry.size > static_cast<quint64>(std::numeric_limits<int>::max())) {
+        return {};
+    }
+
+    quint64 begin = entry.offset;
+    if (entry.method != Entry::kTarMethod) {
+        // ZIP 本地文件头的扩展字段长度可能与目录区不同，需要重新读取
+        if (begin + 30 > length || getU32(data + begin) != kZipLocalHeader) {
+            return {};
+        }
+        begin += 30 + getU16(data + begin + 26) + getU16(data + begin + 28);
+    }
+    if (begin > length || entry.compressedSize > length - begin) {
+        return {};
+    }
+    const uchar *src = data + begin;
+
+    if (entry.method == 0 || entry.method == Entry::kTarMethod) {
+        // 不压缩的条目两个长度必然相等；不相等说明目录区被篡改，按 size 复制会越过映射区
+        if (entry.size != entry.compressedSize) {
+            return {};
+        }
+        return QByteArray(reinterpret_cast<const char *>(src), static_cast<int>(entry.size));
+    }
+    if (entry.method != 8) {
+        return {};
+    }
+
+    QByteArray out(static_cast<int>(entry.size), Qt::Uninitialized);
+    z_stream zs{};
+    if (inflateInit2(&zs, -MAX_WBITS) != Z_OK) {
+        return {};
+    }
+    zs.next_in = const_cast<Bytef *>(src);
+    zs.avail_in = static_cast<uInt>(std::min<quint64>(entry.compressedSize, std::numeric_limits<uInt>::max()));
+    zs.next_out = reinterpret_cast<Bytef *>(out.data());
+    zs.avail_out = static_cast<uInt>(out.size());
+    const int rc = inflate(&zs, Z_FINISH);
+    inflateEnd(&zs);
+    if (rc != Z_STREAM_END || zs.total_out != entry.size) {
+        return {};
+    }
+    return out;
+}
+
+bool ArchiveReader::parseZip() {
+    // 从文件末尾向前查找结束记录（其后最多有 65535 字节注释）
+    if (length < 22) {
+        error = "ZIP 文件已损坏";
+        return false;
+    }
+    const quint64 searchEnd = length > 22 + 65535 ? length - 22 - 65535 : 0;
+    quint64 eocd = length - 22;
+    while (getU32(data + eocd) != kZipEndOfCentral) {
+        if (eocd == searchEnd) {
+            error = "找不到 ZIP 目录区";
+            return false;
+        }
+        --eocd;
+    }
+
+    quint64 count = getU16(data + eocd + 10);
+    quint64 directorySize = getU32(data + eocd + 12);
+    quint64 directoryOffset = getU32(data + eocd + 16);
+    if ((count == kMax16 || directorySize == kMax32 || directoryOffset == kMax32) && eocd >= 20 &&
+        getU32(data + eocd - 20) == kZip64Locator) {
+        const quint64 zip64End = getU64(data + eocd - 20 + 8);
+        if (zip64End + 56 > length || getU32(data + zip64End) != kZip64EndOfCentral) {
+            error = "ZIP64 结束记录已损坏";
+            return false;
+        }
+        count = getU64(data + zip64End + 32);
+        directorySize = getU64(data + zip64End + 40);
+        directoryOffset = getU64(data + zip64End + 48);
+    }
+    if (directoryOffset + directorySize > length) {
+        error = "ZIP 目录区已损坏";
+        return false;
+    }
+
+    items.reserve(static_cast<size_t>(std::min<quint64>(count, directorySize / 46)));
+    quint64 pos = directoryOffset;
+    const quint64 end = directoryOffset + directorySize;
+    for (quint64 i = 0; i < count; ++i) {
+        if (pos + 46 > end || getU32(data + pos) != kZipCentralHeader) {
+            error = "ZIP 目录区已损坏";
+            return false;
+        }
+        const uchar *h = data + pos;
+        const quint16 flags = getU16(h + 8);
+        const quint16 nameLength = getU16(h + 28);
+        const quint16 extraLength = getU16(h + 30);
+        const quint16 commentLength = getU16(h + 32);
+        if (pos + 46 + nameLength + extraLength + commentLength > end) {
+            error = "ZIP 目录区已损坏";
+            return false;
+        }
+
+        Entry entry;
+        entry.method = getU16(h + 10);
+        entry.compressedSize = getU32(h + 20);
+        entry.size = getU32(h + 24);
+        entry.offset = getU32(h + 42);
+        const QByteArray rawName(reinterpret_cast<const char *>(h + 46), nameLength);
+        entry.name = (flags & 0x0800) ? QString::fromUtf8(rawName) : QString::fromLocal8Bit(rawName);
+
+        // ZIP64 扩展字段只包含值为 0xFFFFFFFF 的字段，顺序固定
+        const uchar *extra = h + 46 + nameLength;
+        for (int e = 0; e + 4 <= extraLength;) {
+            const quint16 id = getU16(extra + e);
+            const quint16 size = getU16(extra + e + 2);
+            if (id == 0x0001 && e + 4 + size <= extraLength) {
+                const uchar *field = extra + e + 4;
+                const uchar *fieldEnd = field + size;
+                if (entry.size == kMax32 && field + 8 <= fieldEnd) {
+                    entry.size = getU64(field);
+                    field += 8;
+                }
+                if (entry.compressedSize == kMax32 && field + 8 <= fieldEnd) {
+                    entry.compressedSize = getU64(field);
+                    field += 8;
+                }
+                if (entry.offset == kMax32 && field + 8 <= fieldEnd) {
+                    entry.offset = getU64(field);
+                }
+            }
+            e += 4 + size;
+        }
+
+        // 跳过目录和加密条目
+        if (!entry.name.endsWith('/') && !(flags & 0x0001)) {
+            items.push_back(std::move(entry));
+        }
+        pos += 46 + nameLength + extraLength + commentLength;
+    }
+    return true;
+}
+
+bool ArchiveReader::parseTar() {
+    QByteArray longName;
+    quint64 pos = 0;
+    while (pos + kTarBlock <= length) {
+        const uchar *h = data + pos;
+        if (std::all_of(h, h + kTarBlock, [](uchar c) { return c == 0; })) {
+            break;
+        }
+        const quint64 size = parseOctal(h + 124, 12);
+        const char type = static_cast<char>(h[156]);
+        const quint64 dataOffset = pos + kTarBlock;
+        if (dataOffset + size > length) {
+            error = "TAR 文件已损坏";
+            return false;
+        }
+
+        if (type == 'L') {
+            longName = cString(data + dataOffset, static_cast<int>(size));
+        } else if (type == 'x') {
+            longName = paxPath(QByteArray(reinterpret_cast<const char *>(data + dataOffset), static_cast<int>(size)));
+        } else {
+            if (type == '0' || type == '\0') {
+                QByteArray name = longName;
+                if (name.isEmpty()) {
+                    const QByteArray prefix = cString(h + 345, 155);
+                    name = cString(h, 100);
+                    if (!prefix.isEmpty()) {
+                        name = prefix + '/' + name;
+                    }
+                }
+                items.push_back({QString::fromUtf8(name), dataOffset, size, size, Entry::kTarMethod});
+            }
+            longName.clear();
+        }
+        pos = dataOffset + (size + kTarBlock - 1) / kTarBlock * kTarBlock;
+    }
+    return true;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <vector>
+
+/**
+ * @class ArchiveReader
+ * @brief 读取 ZIP / TAR 压缩包中的条目，用于从 ArchiveWriter 生成的压缩包直接解码
+ *
+ * 打开时将整个文件映射到内存并只解析目录；read() 只读取映射内存，可在多个工作线程中并发调用。
+ * ZIP 支持存储和 deflate 两种压缩方法以及 ZIP64 扩展，TAR 支持 ustar、GNU LongLink 和 pax 长文件名。
+ */
+class ArchiveReader {
+public:
+    /**
+     * @brief 压缩包中的一个文件条目
+     */
+    struct Entry {
+        static constexpr quint16 kTarMethod = 0xFFFF; /**< TAR 条目的 method 取值，此时 offset 即数据偏移 */
+
+        QString name;               /**< 条目名称 */
+        quint64 offset = 0;         /**< ZIP 为本地文件头偏移，TAR 为数据偏移 */
+        quint64 compressedSize = 0; /**< 存储的数据大小 */
+        quint64 size = 0;           /**< 原始大小 */
+        quint16 method = 0;         /**< ZIP 压缩方法：0 存储，8 deflate；TAR 条目为 kTarMethod */
+    };
+
+    /**
+     * @brief 打开压缩包并解析目录
+     * @param path 压缩包路径
+     */
+    explicit ArchiveReader(const QString &path);
+
+    /**
+     * @brief 是否成功打开并解析
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief 失败原因
+     */
+    QString errorString() const;
+
+    /**
+     * @brief 压缩包路径
+     */
+    QString path() const;
+
+    /**
+     * @brief 所有文件条目（不含目录）
+     */
+    const std::vector<Entry> &entries() const;
+
+    /**
+     * @brief 读取条目内容（线程安全）
+     * @param index 条目索引
+     * @return 条目内容，损坏或不支持的压缩方法返回空
+     */
+    QByteArray read(int index) const;
+
+private:
+    /**
+     * @brief 解析 ZIP 目录区
+     */
+    bool parseZip();
+
+    /**
+     * @brief 顺序解析 TAR 头部
+     */
+    bool parseTar();
+
+    QFile file;                  /**< 压缩包文件 */
+    const uchar *data = nullptr; /**< 映射的文件内容 */
+    quint64 length = 0;          /**< 文件大小 */
+    std::vector<Entry> items;    /**< 文件条目 */
+    QString error;               /**< 失败原因 */
+};
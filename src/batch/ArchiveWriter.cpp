@@ -0,0 +1,379 @@
+#include "ArchiveWriter.h"
+#include <QDateTime>
+#include <cstring>
+#include <limits>
+#include <zlib.h>
+
+namespace {
+
+constexpr quint32 kZipLocalHeader = 0x04034b50;
+constexpr quint32 kZipCentralHeader = 0x02014b50;
+constexpr quint32 kZipEndOfCentral = 0x06054b50;
+constexpr quint32 kZip64EndOfCentral = 0x06064b50;
+constexpr quint32 kZip64Locator = 0x07064b50;
+constexpr quint16 kZipUtf8Flag = 0x0800;
+constexpr quint16 kZipVersion = 20;
+constexpr quint16 kZip64Version = 45;
+constexpr quint32 kMax32 = std::numeric_limits<quint32>::max();
+constexpr quint16 kMax16 = std::numeric_limits<quint16>::max();
+constexpr int kTarBlock = 512;
+
+void putU16(QByteArray &out, quint16 v) {
+    out.append(static_cast<char>(v & 0xff));
+    out.append(static_cast<char>(v >> 8));
+}
+
+void putU32(QByteArray &out, quint32 v) {
+    putU16(out, static_cast<quint16>(v & 0xffff));
+    putU16(out, static_cast<quint16>(v >> 16));
+}
+
+void putU64(QByteArray &out, quint64 v) {
+    putU32(out, static_cast<quint32>(v & kMax32));
+    putU32(out, static_cast<quint32>(v >> 32));
+}
+
+quint32 crc32Of(const QByteArray &data) {
+    uLong crc = crc32(0L, Z_NULL, 0);
+    const auto *p = reinterpret_cast<const Bytef *>(data.constData());
+    qint64 left = data.size();
+    while (left > 0) {
+        const auto n = static_cast<uInt>(std::min<qint64>(left, std::numeric_limits<uInt>::max()));
+        crc = crc32(crc, p, n);
+        p += n;
+        left -= n;
+    }
+    return static_cast<quint32>(crc);
+}
+
+/**
+ * @brief 以最快压缩级别做原始 deflate，失败或没有变小时返回空
+ */
+QByteArray deflateFast(const QByteArray &data) {
+    z_stream zs{};
+    if (deflateInit2(&zs, Z_BEST_SPEED, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return {};
+    }
+    QByteArray out;
+    out.resize(static_cast<int>(deflateBound(&zs, static_cast<uLong>(data.size()))));
+    zs.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data.constData()));
+    zs.avail_in = static_cast<uInt>(data.size());
+    zs.next_out = reinterpret_cast<Bytef *>(out.data());
+    zs.avail_out = static_cast<uInt>(out.size());
+    const int rc = deflate(&zs, Z_FINISH);
+    const auto produced = static_cast<qint64>(zs.total_out);
+    deflateEnd(&zs);
+    if (rc != Z_STREAM_END || produced >= data.size()) {
+        return {};
+    }
+    out.resize(static_cast<int>(produced));
+    return out;
+}
+
+/**
+ * @brief 写入 TAR 头部的八进制数字段（以 NUL 结尾）
+ */
+void putOctal(char *field, int width, quint64 value) {
+    const QByteArray digits = QByteArray::number(value, 8).rightJustified(width - 1, '0');
+    memcpy(field, digits.constData(), static_cast<size_t>(width - 1));
+    field[width - 1] = '\0';
+}
+
+/**
+ * @brief 构造 ustar 头部
+ */
+QByteArray tarHeader(const QByteArray &name, quint64 size, char type, qint64 mtime) {
+    QByteArray header(kTarBlock, '\0');
+    char *h = header.data();
+    memcpy(h, name.constData(), static_cast<size_t>(std::min(name.size(), 100)));
+    putOctal(h + 100, 8, 0644);
+    putOctal(h + 108, 8, 0);
+    putOctal(h + 116, 8, 0);
+    putOctal(h + 124, 12, size);
+    putOctal(h + 136, 12, static_cast<quint64>(mtime));
+    memset(h + 148, ' ', 8);
+    h[156] = type;
+    memcpy(h + 257, "ustar", 6);
+    memcpy(h + 263, "00", 2);
+
+    unsigned checksum = 0;
+    for (int i = 0; i < kTarBlock; ++i) {
+        checksum += static_cast<unsigned char>(h[i]);
+    }
+    putOctal(h + 148, 7, checksum);
+    h[155] = ' ';
+    return header;
+}
+
+QByteArray tarPadding(quint64 size) {
+    const int rest = static_cast<int>(size % kTarBlock);
+    return rest == 0 ? QByteArray{} : QByteArray(kTarBlock - rest, '\0');
+}
+
+} // namespace
+
+ArchiveWriter::ArchiveWriter(const QString &path, Format format)
+    : file(path),
+      format(format) {
+    // 所有条目使用同一修改时间
+    const QDateTime now = QDateTime::currentDateTime();
+    const QDate date = now.date();
+    const QTime time = now.time();
+    dosTime = static_cast<quint16>((time.hour() << 11) | (time.minute() << 5) | (time.second() / 2));
+    dosDate = static_cast<quint16>(((std::max(date.year(), 1980) - 1980) << 9) | (date.month() << 5) | date.day());
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        error = file.errorString();
+        failed = true;
+        return;
+    }
+    writer = std::thread(&ArchiveWriter::writerLoop, this);
+}
+
+ArchiveWriter::~ArchiveWriter() {
+    close();
+}
+
+bool ArchiveWriter::isOpen() const {
+    return file.isOpen();
+}
+
+bool ArchiveWriter::add(const QString &name, const QByteArray &data) {
+    if (failed) {
+        return false;
+    }
+
+    Entry entry;
+    entry.name = name.toUtf8();
+    entry.size = static_cast<quint64>(data.size());
+    if (format == Format::Tar) {
+        entry.payload = data;
+    } else {
+        // CRC 和压缩在调用线程中完成，写线程只做顺序写入
+        entry.crc = crc32Of(data);
+        if (format == Format::ZipDeflate) {
+            entry.payload = deflateFast(data);
+        }
+        if (entry.payload.isEmpty()) {
+            entry.payload = data;
+        } else {
+            entry.method = 8;
+        }
+    }
+
+    std::unique_lock lock(mutex);
+    notFull.wait(lock, [this] { return queue.size() < kQueueCapacity || failed || closing; });
+    if (failed || closing) {
+        return false;
+    }
+    queue.push_back(std::move(entry));
+    lock.unlock();
+    notEmpty.notify_one();
+    return true;
+}
+
+bool ArchiveWriter::close() {
+    {
+        std::lock_guard lock(mutex);
+        if (closing) {
+            return !failed;
+        }
+        closing = true;
+    }
+    notEmpty.notify_one();
+    notFull.notify_all();
+    if (writer.joinable()) {
+        writer.join();
+    }
+
+    if (!failed && format != Format::Tar) {
+        writeZipDirectory();
+    } else if (!failed) {
+        // 两个全零块表示 TAR 结束
+        write(QByteArray(2 * kTarBlock, '\0'));
+    }
+    if (file.isOpen()) {
+        file.close();
+        if (!failed && file.error() != QFileDevice::NoError) {
+            fail(file.errorString());
+        }
+    }
+    return !failed;
+}
+
+QString ArchiveWriter::errorString() const {
+    return error;
+}
+
+void ArchiveWriter::fail(const QString &reason) {
+    {
+        std::lock_guard lock(mutex);
+        if (error.isEmpty()) {
+            error = reason;
+        }
+        failed = true;
+    }
+    notFull.notify_all();
+}
+
+void ArchiveWriter::writerLoop() {
+    while (true) {
+        std::unique_lock lock(mutex);
+        notEmpty.wait(lock, [this] { return !queue.empty() || closing; });
+        if (queue.empty()) {
+            return;
+        }
+        Entry entry = std::move(queue.front());
+        queue.pop_front();
+        lock.unlock();
+        notFull.notify_one();
+
+        if (failed) {
+            continue;
+        }
+        if (format == Format::Tar) {
+            writeTarEntry(entry);
+        } else {
+            writeZipEntry(entry);
+        }
+    }
+}
+
+bool ArchiveWriter::write(const QByteArray &bytes) {
+    if (file.write(bytes) != bytes.size()) {
+        fail(file.errorString());
+        return false;
+    }
+    offset += static_cast<quint64>(bytes.size());
+    return true;
+}
+
+bool ArchiveWriter::writeZipEntry(const Entry &entry) {
+    if (entry.size >= kMax32 || static_cast<quint64>(entry.payload.size()) >= kMax32) {
+        fail(QString("条目 %1 超过 4GB").arg(QString::fromUtf8(entry.name)));
+        return false;
+    }
+
+    // 写入前已知大小和 CRC，不需要数据描述符
+    QByteArray header;
+    header.reserve(30 + entry.name.size());
+    putU32(header, kZipLocalHeader);
+    putU16(header, kZipVersion);
+    putU16(header, kZipUtf8Flag);
+    putU16(header, entry.method);
+    putU16(header, dosTime);
+    putU16(header, dosDate);
+    putU32(header, entry.crc);
+    putU32(header, static_cast<quint32>(entry.payload.size()));
+    putU32(header, static_cast<quint32>(entry.size));
+    putU16(header, static_cast<quint16>(entry.name.size()));
+    putU16(header, 0);
+    header += entry.name;
+
+    const quint64 headerOffset = offset;
+    if (!write(header) || !write(entry.payload)) {
+        return false;
+    }
+    central.push_back({entry.name,
+                       static_cast<quint64>(entry.payload.size()),
+                       entry.size,
+                       headerOffset,
+                       entry.crc,
+                       entry.method});
+    return true;
+}
+
+bool ArchiveWriter::writeZipDirectory() {
+    const quint64 directoryOffset = offset;
+
+    QByteArray directory;
+    for (const auto &record : central) {
+        // 偏移超过 4GB 时放进 ZIP64 扩展字段
+        const bool zip64 = record.offset >= kMax32;
+        QByteArray extra;
+        if (zip64) {
+            putU16(extra, 0x0001);
+            putU16(extra, 8);
+            putU64(extra, record.offset);
+        }
+
+        putU32(directory, kZipCentralHeader);
+        putU16(directory, kZip64Version);
+        putU16(directory, zip64 ? kZip64Version : kZipVersion);
+        putU16(directory, kZipUtf8Flag);
+        putU16(directory, record.method);
+        putU16(directory, dosTime);
+        putU16(directory, dosDate);
+        putU32(directory, record.crc);
+        putU32(directory, static_cast<quint32>(record.compressedSize));
+        putU32(directory, static_cast<quint32>(record.size));
+        putU16(directory, static_cast<quint16>(record.name.size()));
+        putU16(directory, static_cast<quint16>(extra.size()));
+        putU16(directory, 0); // 注释
+        putU16(directory, 0); // 磁盘号
+        putU16(directory, 0); // 内部属性
+        putU32(directory, 0); // 外部属性
+        putU32(directory, zip64 ? kMax32 : static_cast<quint32>(record.offset));
+        directory += record.name;
+        directory += extra;
+
+        // 目录区分块写出，避免条目很多时占用大块内存
+        if (directory.size() >= (1 << 20)) {
+            if (!write(directory)) {
+                return false;
+            }
+            directory.clear();
+        }
+    }
+    if (!write(directory)) {
+        return false;
+    }
+
+    const quint64 directorySize = offset - directoryOffset;
+    const quint64 count = central.size();
+    const bool zip64 = count >= kMax16 || directoryOffset >= kMax32 || directorySize >= kMax32;
+
+    QByteArray tail;
+    if (zip64) {
+        const quint64 zip64EndOffset = offset;
+        putU32(tail, kZip64EndOfCentral);
+        putU64(tail, 44);
+        putU16(tail, kZip64Version);
+        putU16(tail, kZip64Version);
+        putU32(tail, 0);
+        putU32(tail, 0);
+        putU64(tail, count);
+        putU64(tail, count);
+        putU64(tail, directorySize);
+        putU64(tail, directoryOffset);
+
+        putU32(tail, kZip64Locator);
+        putU32(tail, 0);
+        putU64(tail, zip64EndOffset);
+        putU32(tail, 1);
+    }
+    putU32(tail, kZipEndOfCentral);
+    putU16(tail, 0);
+    putU16(tail, 0);
+    putU16(tail, zip64 ? kMax16 : static_cast<quint16>(count));
+    putU16(tail, zip64 ? kMax16 : static_cast<quint16>(count));
+    putU32(tail, zip64 ? kMax32 : static_cast<quint32>(directorySize));
+    putU32(tail, zip64 ? kMax32 : static_cast<quint32>(directoryOffset));
+    putU16(tail, 0);
+    return write(tail);
+}
+
+bool ArchiveWriter::writeTarEntry(const Entry &entry) {
+    const qint64 mtime = QDateTime::currentSecsSinceEpoch();
+
+    QByteArray block;
+    if (entry.name.size() >= 100) {
+        // 名称过长时先写一个 GNU LongLink 条目
+        const QByteArray longName = entry.name + '\0';
+        block += tarHeader("././@LongLink", static_cast<quint64>(longName.size()), 'L', mtime);
+        block += longName;
+        block += tarPadding(static_cast<quint64>(longName.size()));
+    }
+    block += tarHeader(entry.name, entry.size, '0', mtime);
+    return write(block) && write(entry.payload) && write(tarPadding(entry.size));
+}
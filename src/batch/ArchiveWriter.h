@@ -0,0 +1,143 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ArchiveWriter
+ * @brief 将批量结果顺序写入单个 ZIP / TAR 文件
+ *
+ * 大批量保存时，每个结果单独创建文件会让网络共享、NTFS 等文件系统的元数据开销占据主导。
+ * add() 可在多个工作线程中并发调用：CRC 计算和压缩在调用线程中完成，
+ * 写入则交给唯一的写线程顺序进行。队列有上限，写盘跟不上时 add() 会阻塞，内存占用不会无限增长。
+ *
+ * ZIP 在条目数或偏移超出 32 位范围时自动使用 ZIP64 扩展。
+ */
+class ArchiveWriter {
+public:
+    /**
+     * @brief 压缩包格式
+     */
+    enum class Format {
+        ZipStore,   /**< ZIP，仅存储 */
+        ZipDeflate, /**< ZIP，快速压缩（压缩后不变小的条目仍以存储方式写入） */
+        Tar,        /**< TAR */
+    };
+
+    /**
+     * @brief 创建压缩包并启动写线程
+     * @param path 压缩包路径
+     * @param format 压缩包格式
+     */
+    ArchiveWriter(const QString &path, Format format);
+
+    /**
+     * @brief 未调用 close() 时自动关闭
+     */
+    ~ArchiveWriter();
+
+    ArchiveWriter(const ArchiveWriter &) = delete;
+    ArchiveWriter &operator=(const ArchiveWriter &) = delete;
+
+    /**
+     * @brief 文件是否成功创建
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief 添加一个条目（线程安全）
+     * @param name 条目名称，调用方负责保证不重复
+     * @param data 条目内容
+     * @return 写入已失败或已关闭时返回 false
+     */
+    bool add(const QString &name, const QByteArray &data);
+
+    /**
+     * @brief 写完队列中剩余的条目和目录区并关闭文件
+     * @return 全部写入成功时返回 true
+     */
+    bool close();
+
+    /**
+     * @brief 失败原因
+     */
+    QString errorString() const;
+
+private:
+    /**
+     * @brief 已完成 CRC 计算和压缩、等待写入的条目
+     */
+    struct Entry {
+        QByteArray name;    /**< UTF-8 条目名 */
+        QByteArray payload; /**< 写入的数据（可能已压缩） */
+        quint64 size = 0;   /**< 原始大小 */
+        quint32 crc = 0;    /**< 原始数据 CRC32 */
+        quint16 method = 0; /**< ZIP 压缩方法：0 存储，8 deflate */
+    };
+
+    /**
+     * @brief ZIP 目录区记录
+     */
+    struct CentralRecord {
+        QByteArray name;        /**< UTF-8 条目名 */
+        quint64 compressedSize; /**< 写入的数据大小 */
+        quint64 size;           /**< 原始大小 */
+        quint64 offset;         /**< 本地文件头偏移 */
+        quint32 crc;            /**< 原始数据 CRC32 */
+        quint16 method;         /**< 压缩方法 */
+    };
+
+    /**
+     * @brief 写线程：按入队顺序写出条目
+     */
+    void writerLoop();
+
+    /**
+     * @brief 写入数据并推进偏移，失败时记录原因
+     */
+    bool write(const QByteArray &bytes);
+
+    /**
+     * @brief 写入 ZIP 本地文件头和数据，并登记目录区记录
+     */
+    bool writeZipEntry(const Entry &entry);
+
+    /**
+     * @brief 写入 ZIP 目录区和结束记录（必要时附带 ZIP64 结束记录）
+     */
+    bool writeZipDirectory();
+
+    /**
+     * @brief 写入 TAR 头部、数据和填充
+     */
+    bool writeTarEntry(const Entry &entry);
+
+    /**
+     * @brief 标记写入失败并唤醒等待中的 add()
+     */
+    void fail(const QString &reason);
+
+    static constexpr std::size_t kQueueCapacity = 64; /**< 待写入条目上限 */
+
+    QFile file;                         /**< 压缩包文件，只在写线程中写入 */
+    const Format format;                /**< 压缩包格式 */
+    quint16 dosTime = 0;                /**< ZIP 条目修改时间（DOS 格式） */
+    quint16 dosDate = 0;                /**< ZIP 条目修改日期（DOS 格式） */
+    quint64 offset = 0;                 /**< 当前写入偏移 */
+    std::vector<CentralRecord> central; /**< ZIP 目录区 */
+    std::deque<Entry> queue;            /**< 待写入条目 */
+    std::mutex mutex;                   /**< 保护 queue / closing / error */
+    std::condition_variable notEmpty;   /**< 队列非空或关闭 */
+    std::condition_variable notFull;    /**< 队列未满或写入失败 */
+    bool closing = false;               /**< 已调用 close() */
+    std::atomic<bool> failed{false};    /**< 写入失败，后续条目直接丢弃 */
+    QString error;                      /**< 失败原因 */
+    std::thread writer;                 /**< 写线程 */
+};
@@ -0,0 +1,275 @@
+#include "BatchJournal.h"
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QUrl>
+#include <algorithm>
+#include <fcntl.h>
+#include <spdlog/spdlog.h>
+
+#ifdef _WIN32
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr char kHeader[] = "# Lab2QRCode batch journal v2\n";
+
+/**
+ * @brief 只追加写入的日志文件，sync() 保证已写入的数据落盘
+ *
+ * QFile 没有提供 fsync 接口，直接使用 C 运行库的文件描述符。
+ */
+class AppendFile {
+public:
+    explicit AppendFile(const QString &path) {
+#ifdef _WIN32
+        fd = _wopen(reinterpret_cast<const wchar_t *>(path.utf16()),
+                    _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY,
+                    _S_IREAD | _S_IWRITE);
+#else
+        fd = ::open(QFile::encodeName(path).constData(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+#endif
+    }
+
+    ~AppendFile() {
+        if (fd >= 0) {
+#ifdef _WIN32
+            _close(fd);
+#else
+            ::close(fd);
+#endif
+        }
+    }
+
+    AppendFile(const AppendFile &) = delete;
+    AppendFile &operator=(const AppendFile &) = delete;
+
+    bool isOpen() const {
+        return fd >= 0;
+    }
+
+    bool write(const QByteArray &data) {
+        const char *p = data.constData();
+        qint64 left = data.size();
+        while (left > 0) {
+#ifdef _WIN32
+            const int n = _write(fd, p, static_cast<unsigned int>(left));
+#else
+            const auto n = ::write(fd, p, static_cast<size_t>(left));
+#endif
+            if (n <= 0) {
+                return false;
+            }
+            p += n;
+            left -= n;
+        }
+        return true;
+    }
+
+    bool sync() {
+#ifdef _WIN32
+        return _commit(fd) == 0;
+#else
+        return ::fsync(fd) == 0;
+#endif
+    }
+
+private:
+    int fd = -1;
+};
+
+/**
+ * @brief 序列化一条记录：状态 \t 输入序号 \t 哈希 \t 输出路径 \n，路径经百分号编码
+ */
+QByteArray serialize(const BatchJournal::Record &record) {
+    QByteArray line;
+    line.reserve(64 + record.outputPath.size());
+    line += record.success ? "ok" : "failed";
+    line += '\t';
+    line += QByteArray::number(record.index);
+    line += '\t';
+    line += record.contentHash;
+    line += '\t';
+    line += QUrl::toPercentEncoding(record.outputPath, "/\\:");
+    line += '\n';
+    return line;
+}
+
+} // namespace
+
+QString BatchJournal::makeKey(const QString &mode, const QString &options, const QStringList &inputs) {
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(kHeader, static_cast<int>(sizeof(kHeader) - 1));
+    hash.addData(mode.toUtf8());
+    hash.addData("\n", 1);
+    hash.addData(options.toUtf8());
+    for (const auto &input : inputs) {
+        hash.addData("\n", 1);
+        hash.addData(input.toUtf8());
+    }
+    return QString::fromLatin1(hash.result().toHex().left(16));
+}
+
+QByteArray BatchJournal::hashContent(const char *data, qint64 size) {
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    // QCryptographicHash::addData 只接受 int 长度，超大文件分块
+    constexpr qint64 kChunk = 1 << 30;
+    for (qint64 offset = 0; offset < size; offset += kChunk) {
+        hash.addData(data + offset, static_cast<int>(std::min(kChunk, size - offset)));
+    }
+    return hash.result().toHex();
+}
+
+BatchJournal::BatchJournal(const QString &directory, const QString &key)
+    : batchKey(key),
+      journalPath(QDir(directory).filePath(key + ".journal")),
+      outputDir(QDir(directory).filePath(key)) {
+    QDir().mkpath(outputDir);
+
+    // 加载上次运行的记录；同一输入以最后一条为准，末尾不完整的行（写到一半崩溃）直接丢弃
+    QFile file(journalPath);
+    if (file.open(QIODevice::ReadOnly)) {
+        const QByteArray content = file.readAll();
+        for (const QByteArray &line : content.split('\n')) {
+            const QList<QByteArray> fields = line.split('\t');
+            if (line.startsWith('#') || fields.size() != 4) {
+                continue;
+            }
+            Record record;
+            bool valid = false;
+            record.success = fields[0] == "ok";
+            record.index = fields[1].toInt(&valid);
+            record.contentHash = fields[2];
+            record.outputPath = QUrl::fromPercentEncoding(fields[3]);
+            if (!valid) {
+                continue;
+            }
+            if (record.success && QFileInfo::exists(record.outputPath)) {
+                completed.insert(record.index, record);
+            } else {
+                completed.remove(record.index);
+            }
+        }
+        if (!content.isEmpty() && !content.endsWith('\n')) {
+            // 补一个换行，避免下一条记录接在残缺行后面
+            buffer.push_back({});
+        }
+        file.close();
+    }
+
+    writer = std::thread(&BatchJournal::writerLoop, this);
+}
+
+BatchJournal::~BatchJournal() {
+    stopWriter();
+}
+
+std::optional<BatchJournal::Record> BatchJournal::findCompleted(int index, const QByteArray &contentHash) const {
+    const auto it = completed.constFind(index);
+    if (it == completed.constEnd() || it->contentHash != contentHash) {
+        return std::nullopt;
+    }
+    return *it;
+}
+
+int BatchJournal::completedCount() const {
+    return completed.size();
+}
+
+void BatchJournal::append(Record record) {
+    bool full;
+    {
+        std::lock_guard lock(mutex);
+        if (stopping) {
+            return;
+        }
+        if (record.success) {
+            outputs.insert(record.index, record.outputPath);
+        }
+        buffer.push_back(std::move(record));
+        full = buffer.size() >= kFlushRecords;
+    }
+    if (full) {
+        cv.notify_one();
+    }
+}
+
+QString BatchJournal::outputPathFor(int index, const QString &suffix) const {
+    return QDir(outputDir).filePath(QString("%1.%2").arg(index).arg(suffix));
+}
+
+QString BatchJournal::outputOf(int index) const {
+    {
+        std::lock_guard lock(mutex);
+        if (const auto it = outputs.constFind(index); it != outputs.constEnd()) {
+            return *it;
+        }
+    }
+    const auto it = completed.constFind(index);
+    return it == completed.constEnd() ? QString{} : it->outputPath;
+}
+
+const QString &BatchJournal::key() const {
+    return batchKey;
+}
+
+void BatchJournal::finish() {
+    stopWriter();
+    QFile::remove(journalPath);
+    QDir(outputDir).removeRecursively();
+}
+
+void BatchJournal::stopWriter() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    cv.notify_one();
+    if (writer.joinable()) {
+        writer.join();
+    }
+}
+
+void BatchJournal::writerLoop() {
+    AppendFile file(journalPath);
+    if (!file.isOpen()) {
+        spdlog::warn("无法打开批处理日志 {}，本次批处理不支持断点续传", journalPath.toStdString());
+    }
+    bool needHeader = file.isOpen() && QFileInfo(journalPath).size() == 0;
+
+    std::unique_lock lock(mutex);
+    while (true) {
+        cv.wait_for(lock, kFlushInterval, [this] { return stopping || buffer.size() >= kFlushRecords; });
+
+        if (!buffer.empty()) {
+            std::vector<Record> batch;
+            batch.swap(buffer);
+            lock.unlock();
+
+            QByteArray chunk;
+            if (needHeader) {
+                chunk += kHeader;
+                needHeader = false;
+            }
+            for (const auto &record : batch) {
+                // 空记录只用于补齐残缺行
+                chunk += record.index < 0 ? QByteArray("\n") : serialize(record);
+            }
+            // 每批只 fsync 一次
+            if (file.isOpen() && !(file.write(chunk) && file.sync())) {
+                spdlog::warn("写入批处理日志 {} 失败", journalPath.toStdString());
+            }
+
+            lock.lock();
+        }
+
+        if (stopping && buffer.empty()) {
+            break;
+        }
+    }
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+/**
+ * @class BatchJournal
+ * @brief 批处理断点续传日志
+ *
+ * 每个批处理（由模式、参数和输入文件列表唯一确定）对应一个只追加的日志文件和一个输出目录。
+ * 工作线程每完成一项，先把结果（PNG 或解码得到的文件）写入输出目录，再追加一行：状态、输入序号、
+ * 输入内容哈希、输出路径。程序崩溃或中途关闭后，以相同输入重新开始该批处理时，
+ * 内容未变且输出文件仍然存在的项直接读取输出文件，不再重新处理。
+ * 输出目录中的文件就是最终结果的编码形式，保存结果时直接复制，不再重新编码。
+ *
+ * 工作线程调用 append() 只是把记录放进内存缓冲区，由独立的写线程批量写盘并每批只 fsync 一次，
+ * 因此对 QtConcurrent::mapped 的工作线程几乎没有额外开销。
+ */
+class BatchJournal {
+public:
+    /**
+     * @brief 单项处理记录
+     */
+    struct Record {
+        int index = -1;         /**< 输入序号 */
+        QByteArray contentHash; /**< 输入内容哈希（十六进制） */
+        QString outputPath;     /**< 输出目录中的结果文件，失败时为空 */
+        bool success = false;   /**< 是否成功 */
+    };
+
+    /**
+     * @brief 由模式、参数和输入文件列表计算批处理标识（记录按输入序号查找，因此与输入顺序有关）
+     * @param mode 批处理模式，如 "generate" / "decode"
+     * @param options 影响结果的参数
+     * @param inputs 输入文件路径
+     * @return 批处理标识
+     */
+    static QString makeKey(const QString &mode, const QString &options, const QStringList &inputs);
+
+    /**
+     * @brief 计算输入内容哈希
+     * @param data 数据指针
+     * @param size 数据长度
+     * @return 十六进制哈希
+     */
+    static QByteArray hashContent(const char *data, qint64 size);
+
+    /**
+     * @brief 打开（或新建）批处理日志，并加载已完成的记录
+     * @param directory 日志所在目录
+     * @param key 批处理标识，见 makeKey()
+     */
+    BatchJournal(const QString &directory, const QString &key);
+
+    /**
+     * @brief 析构时写出缓冲区中剩余的记录，日志和输出目录保留，以便下次续传
+     */
+    ~BatchJournal();
+
+    BatchJournal(const BatchJournal &) = delete;
+    BatchJournal &operator=(const BatchJournal &) = delete;
+
+    /**
+     * @brief 查找上次运行中已成功完成、输入内容未变化且输出文件仍然存在的记录
+     *
+     * 只读取打开日志时加载的数据，可在多个工作线程中并发调用。
+     * @param index 输入序号
+     * @param contentHash 当前输入内容哈希
+     * @return 找到时返回记录
+     */
+    std::optional<Record> findCompleted(int index, const QByteArray &contentHash) const;
+
+    /**
+     * @brief 上次运行中可以直接复用的项数
+     */
+    int completedCount() const;
+
+    /**
+     * @brief 追加一条记录（线程安全，只写入内存缓冲区）
+     */
+    void append(Record record);
+
+    /**
+     * @brief 某一项的结果文件在输出目录中的路径
+     * @param index 输入序号
+     * @param suffix 结果文件后缀，如 "png"
+     */
+    QString outputPathFor(int index, const QString &suffix) const;
+
+    /**
+     * @brief 某一项已写入输出目录的结果文件（本次或上次运行），没有时返回空（线程安全）
+     * @param index 输入序号
+     */
+    QString outputOf(int index) const;
+
+    /**
+     * @brief 批处理标识
+     */
+    const QString &key() const;
+
+    /**
+     * @brief 结果不再需要时调用，删除日志和输出目录
+     */
+    void finish();
+
+private:
+    /**
+     * @brief 写线程：攒够一批或超时后写盘并 fsync
+     */
+    void writerLoop();
+
+    /**
+     * @brief 停止写线程并写出剩余记录
+     */
+    void stopWriter();
+
+    static constexpr std::size_t kFlushRecords = 256;               /**< 缓冲区达到该条数立即写盘 */
+    static constexpr std::chrono::milliseconds kFlushInterval{250}; /**< 最长写盘间隔 */
+
+    QString batchKey;             /**< 批处理标识 */
+    QString journalPath;          /**< 日志文件路径 */
+    QString outputDir;            /**< 输出目录 */
+    QHash<int, Record> completed; /**< 上次运行中可以复用的记录，key 为输入序号 */
+    QHash<int, QString> outputs;  /**< 本次运行中写入输出目录的结果，key 为输入序号 */
+    std::vector<Record> buffer;   /**< 待写盘的记录 */
+    mutable std::mutex mutex;     /**< 保护 outputs / buffer / stopping */
+    std::condition_variable cv;   /**< 唤醒写线程 */
+    bool stopping = false;        /**< 写线程退出标志 */
+    std::thread writer;           /**< 写线程 */
+};
@@ -0,0 +1,102 @@
+#include "BatchPlan.h"
+#include <QCryptographicHash>
+#include <QFile>
+#include <QHash>
+#include <QtConcurrent>
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+
+BatchPlan BatchPlan::identity(int count) {
+    BatchPlan plan;
+    plan.total = count;
+    plan.hashes.resize(count);
+    plan.jobs.resize(count);
+    std::iota(plan.jobs.begin(), plan.jobs.end(), 0);
+    plan.targets.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        plan.targets.push_back({i});
+    }
+    return plan;
+}
+
+BatchPlan BatchPlan::build(int count,
+                           const std::function<qint64(int)> &sizeOf,
+                           const std::function<QByteArray(int)> &hashOf,
+                           const std::function<void(int, int)> &progress) {
+    std::vector<qint64> sizes(count);
+    QHash<qint64, int> sizeCount;
+    for (int i = 0; i < count; ++i) {
+        sizes[i] = sizeOf(i);
+        if (sizes[i] >= 0) {
+            ++sizeCount[sizes[i]];
+        }
+    }
+
+    // 只有大小相同的输入才可能内容相同
+    std::vector<int> candidates;
+    for (int i = 0; i < count; ++i) {
+        if (sizes[i] >= 0 && sizeCount.value(sizes[i]) > 1) {
+            candidates.push_back(i);
+        }
+    }
+
+    std::vector<QByteArray> hashes(count);
+    std::atomic_int hashed{0};
+    QtConcurrent::blockingMap(candidates, [&](int index) {
+        hashes[index] = hashOf(index);
+        if (progress) {
+            progress(++hashed, static_cast<int>(candidates.size()));
+        }
+    });
+
+    BatchPlan plan;
+    plan.total = count;
+    QHash<QByteArray, int> jobOfContent; // (大小 + 哈希) -> 任务索引
+    for (int i = 0; i < count; ++i) {
+        if (!hashes[i].isEmpty()) {
+            const QByteArray key = QByteArray::number(sizes[i]) + ':' + hashes[i];
+            if (const auto it = jobOfContent.constFind(key); it != jobOfContent.constEnd()) {
+                plan.targets[*it].push_back(i);
+                ++plan.duplicateCount;
+                plan.duplicateBytes += sizes[i];
+                continue;
+            }
+            jobOfContent.insert(key, static_cast<int>(plan.jobs.size()));
+        }
+        plan.jobs.push_back(i);
+        plan.targets.push_back({i});
+    }
+
+    // 最大的任务最先执行；大小相同时保持原始顺序
+    std::vector<int> order(plan.jobs.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return sizes[plan.jobs[a]] > sizes[plan.jobs[b]];
+    });
+
+    BatchPlan sorted;
+    sorted.total = plan.total;
+    sorted.duplicateCount = plan.duplicateCount;
+    sorted.duplicateBytes = plan.duplicateBytes;
+    sorted.hashes = std::move(hashes);
+    sorted.jobs.reserve(order.size());
+    sorted.targets.reserve(order.size());
+    for (const int job : order) {
+        sorted.jobs.push_back(plan.jobs[job]);
+        sorted.targets.push_back(std::move(plan.targets[job]));
+    }
+    return sorted;
+}
+
+QByteArray BatchPlan::hashFile(const QString &path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    if (!hash.addData(&file)) {
+        return {};
+    }
+    return hash.result().toHex();
+}
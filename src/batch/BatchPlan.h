@@ -0,0 +1,55 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <functional>
+#include <vector>
+
+/**
+ * @struct BatchPlan
+ * @brief 批处理执行计划：实际执行的任务与原始输入位置之间的映射
+ *
+ * 选择的文件中经常有内容相同、名称不同的副本（复制、重新导出、*_copy.rfa 等）。
+ * 去重后每份内容只处理一次，结果再分发到所有对应的位置。
+ *
+ * 任务按输入大小从大到小排列（LPT 调度）：QtConcurrent 的工作线程按顺序领取下一个任务，
+ * 大文件先开始，批处理末尾只剩小任务，不会出现最后一个大文件独占一个核心、其它核心空闲的长尾。
+ * 结果通过 targets 写回原始位置，输出顺序不受影响。
+ */
+struct BatchPlan {
+    std::vector<int> jobs;                 /**< 实际执行的任务，值为代表输入的原始索引 */
+    std::vector<std::vector<int>> targets; /**< 与 jobs 一一对应，该任务的结果写入的原始索引（含代表自身） */
+    int total = 0;                         /**< 原始输入数 */
+    int duplicateCount = 0;                /**< 因内容重复而省去的任务数 */
+    qint64 duplicateBytes = 0;             /**< 省去处理的输入字节数 */
+    std::vector<QByteArray> hashes;        /**< 与原始输入一一对应的内容哈希，未计算时为空；工作线程直接复用 */
+
+    /**
+     * @brief 每项各自执行，不做去重
+     * @param count 输入数
+     */
+    static BatchPlan identity(int count);
+
+    /**
+     * @brief 按内容去重，并按大小从大到小排列任务
+     *
+     * 先按大小分组（只需 stat），只有与其它输入大小相同的才读取并计算哈希，
+     * 因此输入互不相同时几乎没有额外开销。哈希计算在全局线程池中并行进行，应在后台线程中调用。
+     * @param count 输入数
+     * @param sizeOf 获取输入大小，失败时返回负数（该输入不参与去重，排在最后）
+     * @param hashOf 获取输入内容哈希，失败时返回空（该输入不参与去重）
+     * @param progress 每算完一个哈希调用一次（已完成数，需计算的总数），在工作线程中调用，可为空
+     * @return 执行计划
+     */
+    static BatchPlan build(int count,
+                           const std::function<qint64(int)> &sizeOf,
+                           const std::function<QByteArray(int)> &hashOf,
+                           const std::function<void(int, int)> &progress = {});
+
+    /**
+     * @brief 分块读取文件并计算内容哈希
+     * @param path 文件路径
+     * @return 十六进制哈希，与 BatchJournal::hashContent 一致；无法读取时为空
+     */
+    static QByteArray hashFile(const QString &path);
+};
@@ -0,0 +1,243 @@
+#include "BatchProfiler.h"
+#include <QFileInfo>
+#include <QHash>
+#include <QStringList>
+#include <algorithm>
+#include <atomic>
+#include <magic_enum/magic_enum.hpp>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace {
+
+std::atomic<std::uint64_t> nextProfilerId{1};
+
+/**
+ * @brief 当前线程缓存的缓冲区，属于编号为 owner 的实例
+ */
+struct LocalCache {
+    std::uint64_t owner = 0;
+    void *buffer = nullptr;
+};
+
+thread_local LocalCache localCache;
+thread_local BatchProfiler::ItemTiming *currentItem = nullptr;
+
+std::int64_t elapsedNs(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - since).count();
+}
+
+double toMs(std::int64_t ns) {
+    return static_cast<double>(ns) / 1e6;
+}
+
+/**
+ * @brief 最近秩法求分位数，values 须已排序且非空
+ */
+std::int64_t percentile(const std::vector<std::int64_t> &values, double p) {
+    const auto rank = static_cast<size_t>(p * static_cast<double>(values.size()) + 0.999999);
+    return values[std::clamp<size_t>(rank, 1, values.size()) - 1];
+}
+
+} // namespace
+
+BatchProfiler::Item::Item(BatchProfiler *profiler, const QString &name)
+    : profiler(profiler), outer(currentItem), start(std::chrono::steady_clock::now()) {
+    if (profiler) {
+        timing.name = name;
+        currentItem = &timing;
+    }
+}
+
+BatchProfiler::Item::~Item() {
+    if (!profiler) {
+        return;
+    }
+    currentItem = outer;
+    timing.totalNs = elapsedNs(start);
+    profiler->localBuffer().items.push_back(std::move(timing));
+}
+
+BatchProfiler::Stage::Stage(BatchStage stage)
+    : item(currentItem), stage(stage) {
+    if (item) {
+        start = std::chrono::steady_clock::now();
+    }
+}
+
+BatchProfiler::Stage::~Stage() {
+    if (item) {
+        item->ns[static_cast<int>(stage)] += elapsedNs(start);
+    }
+}
+
+BatchProfiler::BatchProfiler()
+    : id(nextProfilerId.fetch_add(1)), startTime(std::chrono::steady_clock::now()), stopTime(startTime) {}
+
+void BatchProfiler::start() {
+    startTime = std::chrono::steady_clock::now();
+    stopTime = startTime;
+}
+
+void BatchProfiler::stop() {
+    stopTime = std::chrono::steady_clock::now();
+}
+
+BatchProfiler::ThreadBuffer &BatchProfiler::localBuffer() {
+    if (localCache.owner != id) {
+        std::lock_guard lock(mutex);
+        buffers.push_back(std::make_unique<ThreadBuffer>());
+        localCache = {id, buffers.back().get()};
+    }
+    return *static_cast<ThreadBuffer *>(localCache.buffer);
+}
+
+BatchProfiler::Report BatchProfiler::report(int slowestCount) const {
+    std::vector<ItemTiming> all;
+    {
+        std::lock_guard lock(mutex);
+        QHash<QString, size_t> indexOf;
+        for (const auto &buffer : buffers) {
+            for (const auto &item : buffer->items) {
+                if (const auto it = indexOf.constFind(item.name); it != indexOf.constEnd()) {
+                    ItemTiming &merged = all[*it];
+                    for (int s = 0; s < kStageCount; ++s) {
+                        merged.ns[s] += item.ns[s];
+                    }
+                    merged.totalNs += item.totalNs;
+                    continue;
+                }
+                indexOf.insert(item.name, all.size());
+                all.push_back(item);
+            }
+        }
+    }
+
+    Report report;
+    report.items = static_cast<int>(all.size());
+    report.wallSeconds = std::chrono::duration<double>(stopTime - startTime).count();
+    report.itemsPerSecond = report.wallSeconds > 0 ? report.items / report.wallSeconds : 0;
+
+    std::vector<std::int64_t> values;
+    values.reserve(all.size());
+    for (int s = 0; s < kStageCount; ++s) {
+        values.clear();
+        std::int64_t total = 0;
+        for (const auto &item : all) {
+            if (item.ns[s] > 0) {
+                values.push_back(item.ns[s]);
+                total += item.ns[s];
+            }
+        }
+        if (values.empty()) {
+            continue;
+        }
+        std::sort(values.begin(), values.end());
+        StageStats stats;
+        stats.stage = static_cast<BatchStage>(s);
+        stats.count = static_cast<int>(values.size());
+        stats.totalMs = toMs(total);
+        stats.p50Ms = toMs(percentile(values, 0.50));
+        stats.p95Ms = toMs(percentile(values, 0.95));
+        stats.p99Ms = toMs(percentile(values, 0.99));
+        report.stages.push_back(stats);
+    }
+
+    const auto slowest = std::min<size_t>(std::max(slowestCount, 0), all.size());
+    std::partial_sort(all.begin(), all.begin() + slowest, all.end(), [](const ItemTiming &a, const ItemTiming &b) {
+        return a.totalNs > b.totalNs;
+    });
+    report.slowest.assign(all.begin(), all.begin() + slowest);
+    return report;
+}
+
+QString BatchProfiler::stageName(BatchStage stage) {
+    switch (stage) {
+    case BatchStage::Read: return "读取";
+    case BatchStage::Hash: return "哈希";
+    case BatchStage::Base64: return "Base64";
+    case BatchStage::Encode: return "编码";
+    case BatchStage::Raster: return "生成图片";
+    case BatchStage::ImageDecode: return "图片解码";
+    case BatchStage::Detect: return "识别";
+    case BatchStage::Save: return "保存";
+    default: return {};
+    }
+}
+
+QString BatchProfiler::Report::toText() const {
+    QString text = QString("共 %1 项，耗时 %2 秒，吞吐量 %3 项/秒\n\n")
+                       .arg(items)
+                       .arg(wallSeconds, 0, 'f', 2)
+                       .arg(itemsPerSecond, 0, 'f', 1);
+
+    text += QString("%1%2%3%4%5%6\n")
+                .arg("阶段", -10)
+                .arg("项数", 8)
+                .arg("累计(ms)", 12)
+                .arg("p50(ms)", 10)
+                .arg("p95(ms)", 10)
+                .arg("p99(ms)", 10);
+    for (const auto &s : stages) {
+        text += QString("%1%2%3%4%5%6\n")
+                    .arg(stageName(s.stage), -10)
+                    .arg(s.count, 8)
+                    .arg(s.totalMs, 12, 'f', 1)
+                    .arg(s.p50Ms, 10, 'f', 2)
+                    .arg(s.p95Ms, 10, 'f', 2)
+                    .arg(s.p99Ms, 10, 'f', 2);
+    }
+
+    if (!slowest.empty()) {
+        text += QString("\n最慢的 %1 项：\n").arg(slowest.size());
+        for (const auto &item : slowest) {
+            QStringList parts;
+            for (int s = 0; s < kStageCount; ++s) {
+                if (item.ns[s] > 0) {
+                    const auto name = stageName(static_cast<BatchStage>(s));
+                    parts << QString("%1 %2").arg(name).arg(toMs(item.ns[s]), 0, 'f', 1);
+                }
+            }
+            text += QString("%1 ms  %2  (%3)\n")
+                        .arg(toMs(item.totalNs), 8, 'f', 1)
+                        .arg(QFileInfo(item.name).fileName(), parts.join(", "));
+        }
+    }
+    return text;
+}
+
+QByteArray BatchProfiler::Report::toJson() const {
+    json root;
+    root["items"] = items;
+    root["wall_seconds"] = wallSeconds;
+    root["items_per_second"] = itemsPerSecond;
+
+    root["stages"] = json::array();
+    for (const auto &s : stages) {
+        root["stages"].push_back({
+            {"stage", std::string(magic_enum::enum_name(s.stage))},
+            {"count", s.count},
+            {"total_ms", s.totalMs},
+            {"p50_ms", s.p50Ms},
+            {"p95_ms", s.p95Ms},
+            {"p99_ms", s.p99Ms},
+        });
+    }
+
+    root["slowest"] = json::array();
+    for (const auto &item : slowest) {
+        json stagesMs = json::object();
+        for (int s = 0; s < kStageCount; ++s) {
+            if (item.ns[s] > 0) {
+                stagesMs[std::string(magic_enum::enum_name(static_cast<BatchStage>(s)))] = toMs(item.ns[s]);
+            }
+        }
+        root["slowest"].push_back({
+            {"name", item.name.toStdString()},
+            {"total_ms", toMs(item.totalNs)},
+            {"stages_ms", stagesMs},
+        });
+    }
+    return QByteArray::fromStdString(root.dump(2));
+}
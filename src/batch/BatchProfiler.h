@@ -0,0 +1,173 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 批处理单项的处理阶段
+ */
+enum class BatchStage {
+    Read,        /**< 读取输入文件 */
+    Hash,        /**< 计算内容哈希（断点续传） */
+    Base64,      /**< Base64 编码 / 解码 */
+    Encode,      /**< MultiFormatWriter::encode */
+    Raster,      /**< BitMatrix 转为图片 */
+    ImageDecode, /**< 图片文件解码为像素 */
+    Detect,      /**< 条码识别 */
+    Save,        /**< 结果写盘 */
+    Count,
+};
+
+/**
+ * @class BatchProfiler
+ * @brief 批处理分阶段计时与性能报告
+ *
+ * 工作线程中用 Item 标记一项的开始和结束，用 Stage 对其中的各阶段计时（steady_clock）。
+ * 计时数据只写入当前线程自己的缓冲区，每个线程只在第一次使用时加锁登记一次，热路径上没有锁。
+ * 批处理结束（所有工作线程都已完成）后再调用 report() 汇总。
+ */
+class BatchProfiler {
+public:
+    static constexpr int kStageCount = static_cast<int>(BatchStage::Count);
+
+    /**
+     * @brief 单项的计时结果
+     */
+    struct ItemTiming {
+        QString name;                               /**< 输入名称 */
+        std::array<std::int64_t, kStageCount> ns{}; /**< 各阶段耗时（纳秒） */
+        std::int64_t totalNs = 0;                   /**< 总耗时（纳秒） */
+    };
+
+    /**
+     * @brief 单个阶段的统计
+     */
+    struct StageStats {
+        BatchStage stage;   /**< 阶段 */
+        int count = 0;      /**< 执行过该阶段的项数 */
+        double totalMs = 0; /**< 累计耗时 */
+        double p50Ms = 0;   /**< 中位数 */
+        double p95Ms = 0;   /**< 95 分位 */
+        double p99Ms = 0;   /**< 99 分位 */
+    };
+
+    /**
+     * @brief 批处理性能报告
+     */
+    struct Report {
+        int items = 0;                   /**< 处理的项数 */
+        double wallSeconds = 0;          /**< 批处理总耗时 */
+        double itemsPerSecond = 0;       /**< 吞吐量 */
+        std::vector<StageStats> stages;  /**< 各阶段统计（只包含执行过的阶段） */
+        std::vector<ItemTiming> slowest; /**< 总耗时最长的若干项 */
+
+        /**
+         * @brief 生成可读的文本报告
+         */
+        QString toText() const;
+
+        /**
+         * @brief 导出为 JSON
+         */
+        QByteArray toJson() const;
+    };
+
+    /**
+     * @class Item
+     * @brief 标记一项处理的开始和结束（RAII），profiler 为空时不做任何事
+     */
+    class Item {
+    public:
+        Item(BatchProfiler *profiler, const QString &name);
+
+        ~Item();
+
+        Item(const Item &) = delete;
+        Item &operator=(const Item &) = delete;
+
+    private:
+        BatchProfiler *profiler;                     /**< 所属的性能分析器 */
+        ItemTiming timing;                           /**< 本项的计时数据 */
+        ItemTiming *outer;                           /**< 外层的 Item（一般为空） */
+        std::chrono::steady_clock::time_point start; /**< 开始时间 */
+    };
+
+    /**
+     * @class Stage
+     * @brief 对当前线程正在处理的项中的一个阶段计时（RAII），不在 Item 范围内时不做任何事
+     */
+    class Stage {
+    public:
+        explicit Stage(BatchStage stage);
+
+        ~Stage();
+
+        Stage(const Stage &) = delete;
+        Stage &operator=(const Stage &) = delete;
+
+    private:
+        ItemTiming *item;                            /**< 当前线程正在处理的项 */
+        BatchStage stage;                            /**< 阶段 */
+        std::chrono::steady_clock::time_point start; /**< 开始时间 */
+    };
+
+    BatchProfiler();
+
+    /**
+     * @brief 以 stage 阶段计时执行 fn，返回其结果
+     */
+    template <typename F>
+    static auto measure(BatchStage stage, F &&fn) {
+        Stage timer(stage);
+        return std::forward<F>(fn)();
+    }
+
+    /**
+     * @brief 批处理开始，记录起始时间
+     */
+    void start();
+
+    /**
+     * @brief 批处理结束，记录结束时间
+     */
+    void stop();
+
+    /**
+     * @brief 汇总所有线程的计时数据，须在所有工作线程完成后调用
+     *
+     * 同名的项合并为一项：执行计划阶段为去重计算的哈希与该输入在工作线程中的处理计在一起。
+     * @param slowestCount 报告中列出的最慢项数
+     */
+    Report report(int slowestCount = 10) const;
+
+    /**
+     * @brief 阶段的显示名称
+     */
+    static QString stageName(BatchStage stage);
+
+private:
+    /**
+     * @brief 单个线程的计时缓冲区
+     */
+    struct ThreadBuffer {
+        std::vector<ItemTiming> items; /**< 该线程完成的项 */
+    };
+
+    /**
+     * @brief 获取当前线程的缓冲区，首次调用时登记
+     */
+    ThreadBuffer &localBuffer();
+
+    const std::uint64_t id;                             /**< 实例编号，用于识别线程局部缓存是否属于本实例 */
+    std::chrono::steady_clock::time_point startTime;    /**< 批处理开始时间 */
+    std::chrono::steady_clock::time_point stopTime;     /**< 批处理结束时间 */
+    mutable std::mutex mutex;                           /**< 只保护 buffers 的登记 */
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers; /**< 各线程的缓冲区 */
+};
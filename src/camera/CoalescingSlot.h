@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+/**
+ * @class CoalescingSlot
+ * @brief 合并向界面线程投递的更新：任意时刻最多只有一个待处理的事件
+ *
+ * 工作线程每产生一个值就 put()，只有在没有待处理事件时 put() 才返回 true，调用方据此投递一次事件；
+ * 事件执行时 take() 取走最新的值。界面线程跟不上时，中间的值被新值覆盖（丢弃），
+ * 事件队列不会随帧数无限增长，界面显示的总是最新状态。
+ */
+template <typename T>
+class CoalescingSlot {
+public:
+    /**
+     * @brief 放入新值
+     * @param value 新值
+     * @param merge 覆盖尚未取走的旧值之前调用 merge(旧值, 新值)，可把旧值中不能丢失的部分并入新值
+     * @return 是否需要投递事件
+     */
+    template <typename Merge>
+    bool put(T value, Merge &&merge) {
+        {
+            std::lock_guard lock(mutex);
+            if (slot) {
+                merge(*slot, value);
+                ++dropped;
+            }
+            slot = std::move(value);
+        }
+        return !pending.exchange(true, std::memory_order_acq_rel);
+    }
+
+    /**
+     * @brief 放入新值，直接覆盖尚未取走的旧值
+     * @return 是否需要投递事件
+     */
+    bool put(T value) {
+        return put(std::move(value), [](const T &, T &) {});
+    }
+
+    /**
+     * @brief 取走最新的值（在事件中调用），之后的 put() 会重新投递事件
+     */
+    std::optional<T> take() {
+        pending.store(false, std::memory_order_release);
+        std::lock_guard lock(mutex);
+        return std::exchange(slot, std::nullopt);
+    }
+
+    /**
+     * @brief 是否已有尚未执行的事件；生产者可据此跳过生成代价较高、反正会被覆盖的值
+     */
+    bool isPending() const {
+        return pending.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief 被覆盖而未显示的值的数量
+     */
+    std::uint64_t droppedCount() const {
+        std::lock_guard lock(mutex);
+        return dropped;
+    }
+
+private:
+    mutable std::mutex mutex;        /**< 保护 slot 与 dropped */
+    std::optional<T> slot;           /**< 尚未取走的最新值 */
+    std::uint64_t dropped = 0;       /**< 被覆盖的值的数量 */
+    std::atomic_bool pending{false}; /**< 是否已有待处理的事件 */
+};
@@ -0,0 +1,130 @@
+#include "CoarseToFineDetector.h"
+#include <algorithm>
+#include <opencv2/imgproc.hpp>
+
+namespace {
+
+/**
+ * @brief 第二阶段区域至少扩展的像素数，保证条码静区完整
+ */
+constexpr int kMinPaddingPx = 16;
+
+ZXing::ImageView viewOf(const cv::Mat &image) {
+    auto format = ZXing::ImageFormat::None;
+    switch (image.channels()) {
+    case 1: format = ZXing::ImageFormat::Lum; break;
+    case 3: format = ZXing::ImageFormat::BGR; break;
+    case 4: format = ZXing::ImageFormat::BGRA; break;
+    default: break;
+    }
+    if (format == ZXing::ImageFormat::None || image.depth() != CV_8U) {
+        return {nullptr, 0, 0, ZXing::ImageFormat::None};
+    }
+    return {image.data, image.cols, image.rows, format, static_cast<int>(image.step)};
+}
+
+} // namespace
+
+CoarseToFineDetector::CoarseToFineDetector(std::vector<int> scales, double padding)
+    : scaleList(std::move(scales)), padding(std::max(padding, 0.0)) {
+    std::erase_if(scaleList, [](int scale) { return scale < 1; });
+    if (scaleList.empty()) {
+        scaleList.push_back(1);
+    }
+}
+
+const std::vector<int> &CoarseToFineDetector::scales() const {
+    return scaleList;
+}
+
+std::vector<CoarseToFineDetector::Detection>
+CoarseToFineDetector::decode(const cv::Mat &image, const cv::Point &offset, const ZXing::ReaderOptions &options) {
+    std::vector<Detection> detections;
+    for (auto &bc : ZXing::ReadBarcodes(viewOf(image), options)) {
+        if (!bc.isValid()) {
+            continue;
+        }
+        ZXing::Position position = bc.position();
+        for (auto &p : position) {
+            p.x += offset.x;
+            p.y += offset.y;
+        }
+        detections.push_back({std::move(bc), position});
+    }
+    return detections;
+}
+
+std::vector<CoarseToFineDetector::Detection>
+CoarseToFineDetector::detect(const cv::Mat &frame, const ZXing::ReaderOptions &options) const {
+    // 灰度图和各级缩小图按线程复用，尺寸不变时不再分配
+    thread_local cv::Mat grayBuffer;
+    cv::Mat gray = frame;
+    if (frame.channels() == 3) {
+        cv::cvtColor(frame, grayBuffer, cv::COLOR_BGR2GRAY);
+        gray = grayBuffer;
+    } else if (frame.channels() == 4) {
+        cv::cvtColor(frame, grayBuffer, cv::COLOR_BGRA2GRAY);
+        gray = grayBuffer;
+    }
+
+    thread_local std::vector<cv::Mat> smallBuffers;
+    smallBuffers.resize(scaleList.size());
+    for (std::size_t i = 0; i < scaleList.size(); ++i) {
+        const int scale = scaleList[i];
+        auto detections =
+            scale == 1 ? decode(gray, {0, 0}, options) : detectAt(gray, scale, smallBuffers[i], options);
+        if (!detections.empty()) {
+            return detections;
+        }
+    }
+    return {};
+}
+
+std::vector<CoarseToFineDetector::Detection>
+CoarseToFineDetector::detectAt(const cv::Mat &gray,
+                               int scale,
+                               cv::Mat &small,
+                               const ZXing::ReaderOptions &options) const {
+    cv::resize(gray, small, cv::Size(), 1.0 / scale, 1.0 / scale, cv::INTER_AREA);
+
+    // 第一阶段：缩小图上定位，已定位但无法解码的条码也返回，交给第二阶段；未选中的格式在 ZXing 内部就不会尝试
+    ZXing::ReaderOptions coarseOptions = options;
+    coarseOptions.setReturnErrors(true);
+    const auto located = ZXing::ReadBarcodes(viewOf(small), coarseOptions);
+
+    const cv::Rect frameRect({0, 0}, gray.size());
+    std::vector<Detection> detections;
+    for (const auto &bc : located) {
+        if (bc.format() == ZXing::BarcodeFormat::None) {
+            continue;
+        }
+
+        ZXing::Position position = bc.position();
+        std::vector<cv::Point> corners;
+        for (auto &p : position) {
+            p.x = p.x * scale + scale / 2;
+            p.y = p.y * scale + scale / 2;
+            corners.emplace_back(p.x, p.y);
+        }
+
+        // 第二阶段：只在定位到的区域按原分辨率识别，格式已知
+        const cv::Rect box = cv::boundingRect(corners);
+        const int pad =
+            std::max({kMinPaddingPx, scale * 4, static_cast<int>(std::max(box.width, box.height) * padding)});
+        const cv::Rect roi = cv::Rect(box.x - pad, box.y - pad, box.width + 2 * pad, box.height + 2 * pad) & frameRect;
+        if (roi.area() > 0) {
+            ZXing::ReaderOptions fineOptions = options;
+            fineOptions.setFormats(bc.format());
+            if (auto fine = decode(gray(roi), roi.tl(), fineOptions); !fine.empty()) {
+                detections.push_back(std::move(fine.front()));
+                continue;
+            }
+        }
+
+        // 原分辨率下反而失败（如运动模糊），接受缩小图上已解码的结果
+        if (bc.isValid()) {
+            detections.push_back({bc, position});
+        }
+    }
+    return detections;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <ZXing/ReadBarcode.h>
+#include <opencv2/core.hpp>
+#include <vector>
+
+/**
+ * @class CoarseToFineDetector
+ * @brief 先在缩小的灰度图上定位条码，再只在定位到的区域按原分辨率识别
+ *
+ * 整帧按原分辨率识别的开销与像素数成正比，4K 画面上很慢。第一阶段把灰度图缩小 2 倍或 4 倍后识别，
+ * 并让 ZXing 返回已定位但未能解码的条码；第二阶段在这些位置（扩展后）按原分辨率重新识别，
+ * 因此缩小后无法解码的高密度条码也能识别。原分辨率识别失败时，接受缩小图上已成功解码的结果。
+ * 缩放倍数按顺序尝试，前一个倍数没有找到任何条码时才尝试下一个；倍数 1 表示整帧原分辨率识别。
+ */
+class CoarseToFineDetector {
+public:
+    /**
+     * @brief 识别结果
+     */
+    struct Detection {
+        ZXing::Barcode barcode;   /**< 条码 */
+        ZXing::Position position; /**< 条码在整帧中的位置 */
+    };
+
+    /**
+     * @param scales 依次尝试的缩小倍数，为空时等同于 {1}
+     * @param padding 第二阶段区域向四周扩展的比例（相对条码外接矩形的长边）
+     */
+    explicit CoarseToFineDetector(std::vector<int> scales, double padding = 0.25);
+
+    /**
+     * @brief 识别一帧（线程安全）
+     * @param frame BGR / BGRA / 灰度图
+     * @param options 识别参数，其中的格式限制和 try 选项同时用于两个阶段
+     * @return 有效的条码，位置为整帧坐标
+     */
+    std::vector<Detection> detect(const cv::Mat &frame, const ZXing::ReaderOptions &options = {}) const;
+
+    /**
+     * @brief 缩小倍数
+     */
+    const std::vector<int> &scales() const;
+
+    /**
+     * @brief 以原分辨率识别图像中的条码
+     * @param image BGR / BGRA / 灰度图或其子图
+     * @param offset image 左上角在整帧中的位置
+     * @param options 识别参数
+     */
+    static std::vector<Detection>
+    decode(const cv::Mat &image, const cv::Point &offset, const ZXing::ReaderOptions &options);
+
+private:
+    /**
+     * @brief 以 scale 倍缩小后定位，并在原分辨率下重新识别
+     * @param small 缩小图的缓冲区，尺寸不变时复用
+     * @param options 识别参数
+     */
+    std::vector<Detection>
+    detectAt(const cv::Mat &gray, int scale, cv::Mat &small, const ZXing::ReaderOptions &options) const;
+
+    std::vector<int> scaleList; /**< 缩小倍数 */
+    double padding;             /**< 第二阶段区域扩展比例 */
+};
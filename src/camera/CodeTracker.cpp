@@ -0,0 +1,52 @@
+#include "CodeTracker.h"
+#include <algorithm>
+#include <limits>
+
+CodeTracker::CodeTracker(std::chrono::milliseconds ttl)
+    : ttl(ttl) {}
+
+std::vector<CodeTracker::Match> CodeTracker::update(const std::vector<Observation> &observations,
+                                                    clock::time_point timestamp) {
+    std::lock_guard lock(mutex);
+
+    // 识别池乱序完成，较早的帧可能晚到；只淘汰相对本帧已超时的轨迹
+    std::erase_if(tracks, [&](const Track &track) { return timestamp - track.lastSeen > ttl; });
+
+    std::vector<Match> matches;
+    matches.reserve(observations.size());
+    std::vector<bool> taken(tracks.size(), false);
+    for (const auto &observation : observations) {
+        std::size_t best = tracks.size();
+        float bestDistance = std::numeric_limits<float>::max();
+        for (std::size_t i = 0; i < tracks.size(); ++i) {
+            const auto &track = tracks[i];
+            if (taken[i] || track.format != observation.format || track.content != observation.content) {
+                continue;
+            }
+            const cv::Point2f diff = track.center - observation.center;
+            const float distance = diff.dot(diff);
+            if (distance < bestDistance) {
+                best = i;
+                bestDistance = distance;
+            }
+        }
+
+        if (best < tracks.size()) {
+            auto &track = tracks[best];
+            taken[best] = true;
+            track.center = observation.center;
+            track.lastSeen = std::max(track.lastSeen, timestamp);
+            matches.push_back({track.id, false});
+        } else {
+            tracks.push_back({nextId++, observation.format, observation.content, observation.center, timestamp});
+            taken.push_back(true);
+            matches.push_back({tracks.back().id, true});
+        }
+    }
+    return matches;
+}
+
+void CodeTracker::reset() {
+    std::lock_guard lock(mutex);
+    tracks.clear();
+}
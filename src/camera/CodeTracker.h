@@ -0,0 +1,73 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <opencv2/core.hpp>
+#include <string>
+#include <vector>
+
+/**
+ * @class CodeTracker
+ * @brief 连续扫描中的多条码跟踪：为每个条码分配稳定的编号，只在条码首次出现时报告“新条码”
+ *
+ * 轨迹以（格式，内容）为主键，同一帧中出现多个相同内容的条码时再按位置区分：
+ * 每个观测匹配同一主键下距离最近的未被占用的轨迹，没有可用轨迹时新建。
+ * 轨迹超过 ttl 未被观测到即失效，之后再出现视为新条码。
+ * 识别池的多个工作线程共享同一个跟踪器，用互斥锁保护。
+ */
+class CodeTracker {
+public:
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * @brief 一帧中识别到的条码
+     */
+    struct Observation {
+        int format = 0;      /**< 条码格式（ZXing::BarcodeFormat 的值） */
+        std::string content; /**< 条码内容 */
+        cv::Point2f center;  /**< 条码中心（帧像素坐标） */
+    };
+
+    /**
+     * @brief 观测对应的轨迹
+     */
+    struct Match {
+        int id = 0;         /**< 轨迹编号，从 1 开始递增 */
+        bool isNew = false; /**< 是否为新出现的条码 */
+    };
+
+    /**
+     * @param ttl 轨迹未被观测到后保留的时长
+     */
+    explicit CodeTracker(std::chrono::milliseconds ttl);
+
+    /**
+     * @brief 用一帧的识别结果更新轨迹
+     * @param observations 本帧识别到的全部条码
+     * @param timestamp 帧的采集时间
+     * @return 与 observations 一一对应的轨迹
+     */
+    std::vector<Match> update(const std::vector<Observation> &observations, clock::time_point timestamp);
+
+    /**
+     * @brief 清空全部轨迹（切换摄像头等画面不连续时调用）
+     */
+    void reset();
+
+private:
+    /**
+     * @brief 一个条码的轨迹
+     */
+    struct Track {
+        int id;                     /**< 轨迹编号 */
+        int format;                 /**< 条码格式 */
+        std::string content;        /**< 条码内容 */
+        cv::Point2f center;         /**< 最近一次观测到的中心 */
+        clock::time_point lastSeen; /**< 最近一次观测到的采集时间 */
+    };
+
+    const std::chrono::milliseconds ttl; /**< 轨迹保留时长 */
+    std::mutex mutex;                    /**< 保护以下状态 */
+    std::vector<Track> tracks;           /**< 当前有效的轨迹 */
+    int nextId = 1;                      /**< 下一个轨迹编号 */
+};
@@ -0,0 +1,165 @@
+#include "DebugFrameWriter.h"
+#include "sysinfo.h"
+#include <algorithm>
+#include <format>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+#include <spdlog/spdlog.h>
+
+namespace {
+
+std::chrono::steady_clock::duration intervalOf(double maxPerSecond) {
+    if (maxPerSecond <= 0) {
+        return std::chrono::steady_clock::duration::zero(); // 不限速
+    }
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / maxPerSecond));
+}
+
+/**
+ * @brief 在图像上绘制条码的边界框和文本
+ */
+void drawOutline(cv::Mat &img, const BarcodeOutline &outline) {
+    std::vector<cv::Point> pts;
+    for (const auto &p : outline.polygon) {
+        pts.emplace_back(p.x(), p.y());
+    }
+    if (pts.size() < 4) {
+        return;
+    }
+    cv::polylines(img, pts, true, CV_RGB(0, 255, 0));
+    cv::putText(
+        img, outline.text.toStdString(), pts[3] + cv::Point(0, 20), cv::FONT_HERSHEY_DUPLEX, 0.5, CV_RGB(0, 255, 0));
+}
+
+} // namespace
+
+DebugFrameWriter::DebugFrameWriter(DebugFrameConfig config)
+    : config(std::move(config)), minInterval(intervalOf(this->config.maxPerSecond)) {
+    if (this->config.enabled) {
+        thread = std::thread(&DebugFrameWriter::run, this);
+    }
+}
+
+DebugFrameWriter::~DebugFrameWriter() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    ready.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+bool DebugFrameWriter::submit(const cv::Mat &frame, std::vector<BarcodeOutline> outlines, const std::string &tag) {
+    if (!config.enabled || frame.empty()) {
+        return false;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard lock(mutex);
+        const bool limited = sequence > 0 && now - lastAccepted < minInterval;
+        if (stopping || limited || queue.size() >= static_cast<std::size_t>(config.queueSize)) {
+            ++dropped;
+            return false;
+        }
+        lastAccepted = now;
+        const auto filename = std::format(
+            "scan_{}_{}_{}.{}", tag, sysinfo::getCurrentTimeString("%Y-%m-%d_%H-%M-%S"), sequence++, config.format);
+        queue.push_back({frame, std::move(outlines), filename});
+    }
+    ready.notify_one();
+    return true;
+}
+
+std::uint64_t DebugFrameWriter::droppedCount() const {
+    std::lock_guard lock(mutex);
+    return dropped;
+}
+
+std::size_t DebugFrameWriter::maxHeldFrames() const {
+    return config.enabled ? static_cast<std::size_t>(std::max(config.queueSize, 0)) + 1 : 0;
+}
+
+void DebugFrameWriter::run() {
+    scanExisting();
+    while (true) {
+        Job job;
+        {
+            std::unique_lock lock(mutex);
+            ready.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) {
+                return; // 正在停止且队列已写完
+            }
+            job = std::move(queue.front());
+            queue.pop_front();
+        }
+        write(job);
+    }
+}
+
+void DebugFrameWriter::write(const Job &job) {
+    // 标记画在副本上：job.frame 是采集缓冲区的租约，不能修改；灰度帧转为彩色以便标记
+    cv::Mat marked;
+    if (job.frame.channels() == 1) {
+        cv::cvtColor(job.frame, marked, cv::COLOR_GRAY2BGR);
+    } else {
+        marked = job.frame.clone();
+    }
+    for (const auto &outline : job.outlines) {
+        drawOutline(marked, outline);
+    }
+
+    std::vector<int> params;
+    if (config.format == "jpg") {
+        params = {cv::IMWRITE_JPEG_QUALITY, config.jpegQuality};
+    } else {
+        params = {cv::IMWRITE_PNG_COMPRESSION, config.pngCompression};
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(config.directory, ec);
+    const auto path = std::filesystem::path(config.directory) / job.filename;
+    try {
+        if (!cv::imwrite(path.string(), marked, params)) {
+            spdlog::warn("调试帧保存失败: {}", path.string());
+            return;
+        }
+    } catch (const cv::Exception &e) {
+        spdlog::warn("调试帧保存失败: {} ({})", path.string(), e.what());
+        return;
+    }
+
+    const auto size = std::filesystem::file_size(path, ec);
+    saved.push_back({path, ec ? 0 : size});
+    savedBytes += saved.back().size;
+    enforceRetention();
+}
+
+void DebugFrameWriter::scanExisting() {
+    std::error_code ec;
+    std::vector<std::pair<std::filesystem::file_time_type, SavedFile>> files;
+    for (const auto &entry : std::filesystem::directory_iterator(config.directory, ec)) {
+        if (!entry.is_regular_file(ec) || !entry.path().filename().string().starts_with("scan_")) {
+            continue;
+        }
+        files.push_back({entry.last_write_time(ec), {entry.path(), entry.file_size(ec)}});
+    }
+    std::sort(files.begin(), files.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+    for (auto &[time, file] : files) {
+        savedBytes += file.size;
+        saved.push_back(std::move(file));
+    }
+    enforceRetention();
+}
+
+void DebugFrameWriter::enforceRetention() {
+    const auto maxBytes = static_cast<std::uintmax_t>(config.maxMegabytes) * 1024 * 1024;
+    while (!saved.empty() && (saved.size() > static_cast<std::size_t>(config.maxFiles) || savedBytes > maxBytes)) {
+        std::error_code ec;
+        std::filesystem::remove(saved.front().path, ec);
+        savedBytes -= saved.front().size;
+        saved.pop_front();
+    }
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "ScanConfig.h"
+#include "commondef.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @class DebugFrameWriter
+ * @brief 在后台线程中保存识别到新条码时的整帧图像，界面线程不接触磁盘
+ *
+ * 1080p 帧编码为 PNG 需要几十毫秒，在界面线程中同步写盘会卡住界面。
+ * submit() 只把帧（采集缓冲区的租约，不复制）放入有界队列，超过每秒限额或队列已满时直接丢弃；
+ * 标记绘制、编码和写盘都在后台线程中完成。写入后按文件数和总大小上限删除目录中最旧的文件。
+ */
+class DebugFrameWriter {
+public:
+    /**
+     * @brief 创建并启动写盘线程
+     * @param config 保存参数
+     */
+    explicit DebugFrameWriter(DebugFrameConfig config);
+
+    /**
+     * @brief 写完队列中剩余的帧后停止写盘线程
+     */
+    ~DebugFrameWriter();
+
+    DebugFrameWriter(const DebugFrameWriter &) = delete;
+    DebugFrameWriter &operator=(const DebugFrameWriter &) = delete;
+
+    /**
+     * @brief 提交一帧，不阻塞
+     * @param frame 视频帧，只读共享，保存时在副本上绘制标记
+     * @param outlines 需要标记的条码轮廓
+     * @param tag 文件名中的标签（如条码类型）
+     * @return 是否被接受；未启用、超过速率限制或队列已满时返回 false
+     */
+    bool submit(const cv::Mat &frame, std::vector<BarcodeOutline> outlines, const std::string &tag);
+
+    /**
+     * @brief 因速率限制或队列已满被丢弃的帧数
+     */
+    std::uint64_t droppedCount() const;
+
+    /**
+     * @brief 最多同时持有的帧数（队列中的帧加正在写盘的一帧），未启用时为 0；采集缓冲区池需要为此预留
+     */
+    std::size_t maxHeldFrames() const;
+
+private:
+    /**
+     * @brief 等待写盘的帧
+     */
+    struct Job {
+        cv::Mat frame;                        /**< 视频帧 */
+        std::vector<BarcodeOutline> outlines; /**< 条码轮廓 */
+        std::string filename;                 /**< 文件名（不含目录） */
+    };
+
+    /**
+     * @brief 目录中已保存的文件
+     */
+    struct SavedFile {
+        std::filesystem::path path; /**< 文件路径 */
+        std::uintmax_t size;        /**< 文件大小 */
+    };
+
+    /**
+     * @brief 写盘线程主循环
+     */
+    void run();
+
+    /**
+     * @brief 绘制标记、编码并写盘
+     */
+    void write(const Job &job);
+
+    /**
+     * @brief 登记目录中已有的调试帧（写盘线程启动时调用一次）
+     */
+    void scanExisting();
+
+    /**
+     * @brief 删除最旧的文件，直到文件数和总大小都不超过上限
+     */
+    void enforceRetention();
+
+    const DebugFrameConfig config;                         /**< 保存参数 */
+    const std::chrono::steady_clock::duration minInterval; /**< 两次保存之间的最短间隔 */
+
+    mutable std::mutex mutex;                           /**< 保护 queue、stopping、lastAccepted、dropped 与 sequence */
+    std::condition_variable ready;                      /**< 有新帧或停止时通知 */
+    std::deque<Job> queue;                              /**< 等待写盘的帧 */
+    bool stopping = false;                              /**< 是否正在停止 */
+    std::chrono::steady_clock::time_point lastAccepted; /**< 上次接受提交的时间 */
+    std::uint64_t dropped = 0;                          /**< 被丢弃的帧数 */
+    std::uint64_t sequence = 0;                         /**< 文件名序号，避免同一秒内重名 */
+
+    std::deque<SavedFile> saved;   /**< 目录中的文件，按时间从旧到新（只在写盘线程中访问） */
+    std::uintmax_t savedBytes = 0; /**< saved 的总大小 */
+    std::thread thread;            /**< 写盘线程，最后初始化 */
+};
@@ -0,0 +1,142 @@
+#include "DecodePool.h"
+#include "sysinfo.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/**
+ * @brief ReadBarcodes 全格式识别每百万像素的经验耗时（毫秒）
+ */
+constexpr double kDecodeMsPerMegapixel = 25.0;
+
+} // namespace
+
+DecodePool::DecodePool(int workers, Decoder decoder, Sink sink)
+    : decoder(std::move(decoder)), sink(std::move(sink)), capacity(static_cast<std::size_t>(std::max(workers, 1))),
+      queue(capacity), pending(capacity) {
+    threads.reserve(capacity);
+    for (std::size_t i = 0; i < capacity; ++i) {
+        threads.emplace_back(&DecodePool::workerLoop, this);
+    }
+}
+
+DecodePool::~DecodePool() {
+    {
+        std::lock_guard lock(queueMutex);
+        stopping = true;
+        for (auto &job : queue) {
+            job.frame.release();
+        }
+        queueSize = 0;
+    }
+    queueReady.notify_all();
+    for (auto &thread : threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+void DecodePool::submit(const cv::Mat &frame, std::chrono::steady_clock::time_point timestamp) {
+    {
+        std::lock_guard lock(queueMutex);
+        if (stopping) {
+            return;
+        }
+        if (queueSize == capacity) {
+            queueHead = (queueHead + 1) % capacity; // 覆盖最旧的帧
+            --queueSize;
+            ++dropped;
+        }
+        queue[(queueHead + queueSize) % capacity] = {nextSequence++, frame, timestamp};
+        ++queueSize;
+    }
+    queueReady.notify_one();
+}
+
+int DecodePool::workerCount() const {
+    return static_cast<int>(threads.size());
+}
+
+std::uint64_t DecodePool::droppedCount() const {
+    std::lock_guard lock(queueMutex);
+    return dropped;
+}
+
+std::size_t DecodePool::queueDepth() const {
+    std::lock_guard lock(queueMutex);
+    return queueSize;
+}
+
+int DecodePool::suggestedWorkers(double fps, int width, int height) {
+    const int cores = static_cast<int>(sysinfo::getCPUCoreCount());
+    const int available = std::max(cores - 2, 1);
+    if (fps <= 0 || width <= 0 || height <= 0) {
+        return std::min(available, 2);
+    }
+    const double frameMs = kDecodeMsPerMegapixel * width * height / 1e6;
+    const int needed = static_cast<int>(std::ceil(frameMs * fps / 1000.0));
+    return std::clamp(needed, 1, available);
+}
+
+void DecodePool::workerLoop() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock lock(queueMutex);
+            queueReady.wait(lock, [this] { return stopping || queueSize > 0; });
+            if (stopping) {
+                return;
+            }
+            job = std::move(queue[queueHead]);
+            queueHead = (queueHead + 1) % capacity;
+            --queueSize;
+
+            // 在释放队列锁之前登记，保证比它更晚取出的帧不会先被输出
+            std::lock_guard order(orderMutex);
+            if (pendingSize == pending.size()) {
+                growPending();
+            }
+            auto &slot = pending[(pendingHead + pendingSize) % pending.size()];
+            slot.sequence = job.sequence;
+            slot.done = false;
+            ++pendingSize;
+        }
+
+        FrameResult result;
+        result.timestamp = job.timestamp;
+        decoder(job.frame, result);
+        complete(job.sequence, std::move(result));
+    }
+}
+
+void DecodePool::complete(std::uint64_t sequence, FrameResult &&result) {
+    std::lock_guard lock(orderMutex);
+    for (std::size_t i = 0; i < pendingSize; ++i) {
+        auto &slot = pending[(pendingHead + i) % pending.size()];
+        if (slot.sequence == sequence) {
+            slot.result = std::move(result);
+            slot.done = true;
+            break;
+        }
+    }
+
+    // 从最早取出的帧开始，输出所有已完成的结果，遇到未完成的帧为止
+    while (pendingSize > 0 && pending[pendingHead].done) {
+        auto &slot = pending[pendingHead];
+        sink(std::move(slot.result));
+        slot.result = {};
+        pendingHead = (pendingHead + 1) % pending.size();
+        --pendingSize;
+    }
+}
+
+void DecodePool::growPending() {
+    std::vector<Pending> grown(pending.size() * 2);
+    for (std::size_t i = 0; i < pendingSize; ++i) {
+        grown[i] = std::move(pending[(pendingHead + i) % pending.size()]);
+    }
+    pending = std::move(grown);
+    pendingHead = 0;
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "commondef.h"
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class DecodePool
+ * @brief 多线程条码识别池：多个工作线程并行识别，结果按采集顺序依次输出
+ *
+ * 高分辨率摄像头单帧识别耗时可能超过一个帧间隔，单个识别线程跟不上。
+ * 采集线程把帧放入有界队列，队列满时丢弃最旧的帧，保证积压不超过工作线程数、识别的始终是较新的画面。
+ * 工作线程按先进先出取帧，完成顺序可能乱序；结果先暂存，等所有更早取出的帧都完成后才按序交给 sink，
+ * 因此界面上的结果不会“倒退”到更旧的画面。
+ * 等待队列和结果排序都使用容量固定的环形缓冲区，稳定运行时不再为每帧分配内存。
+ */
+class DecodePool {
+public:
+    using Decoder = std::function<void(const cv::Mat &, FrameResult &)>; /**< 识别一帧，在工作线程中调用 */
+    using Sink = std::function<void(FrameResult &&)>;                    /**< 按采集顺序接收结果，在工作线程中调用 */
+
+    /**
+     * @brief 创建并启动工作线程
+     * @param workers 工作线程数（至少 1）
+     * @param decoder 识别函数，须可在多个线程中并发调用；调用时结果的 timestamp 已填为采集时间
+     * @param sink 结果回调，调用时持有内部锁，应尽快返回（如投递到界面线程）
+     */
+    DecodePool(int workers, Decoder decoder, Sink sink);
+
+    /**
+     * @brief 停止并等待所有工作线程，未处理的帧直接丢弃
+     */
+    ~DecodePool();
+
+    DecodePool(const DecodePool &) = delete;
+    DecodePool &operator=(const DecodePool &) = delete;
+
+    /**
+     * @brief 提交一帧，队列已满时丢弃最旧的帧
+     * @param frame 视频帧，只读共享
+     * @param timestamp 采集时间
+     */
+    void submit(const cv::Mat &frame, std::chrono::steady_clock::time_point timestamp);
+
+    /**
+     * @brief 工作线程数
+     */
+    int workerCount() const;
+
+    /**
+     * @brief 因积压被丢弃的帧数
+     */
+    std::uint64_t droppedCount() const;
+
+    /**
+     * @brief 等待识别的帧数
+     */
+    std::size_t queueDepth() const;
+
+    /**
+     * @brief 根据 CPU 核心数、帧率和分辨率估算所需的工作线程数
+     *
+     * 按每百万像素的经验识别耗时估算单帧耗时，再乘以帧率得到满帧率所需的并行度；
+     * 结果不超过核心数减去采集和界面线程占用的 2 个核心。
+     * @param fps 摄像头帧率
+     * @param width 帧宽度
+     * @param height 帧高度
+     */
+    static int suggestedWorkers(double fps, int width, int height);
+
+private:
+    /**
+     * @brief 队列中等待识别的帧
+     */
+    struct Job {
+        std::uint64_t sequence;                          /**< 采集序号 */
+        cv::Mat frame;                                   /**< 视频帧 */
+        std::chrono::steady_clock::time_point timestamp; /**< 采集时间 */
+    };
+
+    /**
+     * @brief 已被工作线程取出的帧，按取出顺序排列
+     */
+    struct Pending {
+        std::uint64_t sequence = 0; /**< 采集序号 */
+        bool done = false;          /**< 是否已完成 */
+        FrameResult result;         /**< 识别结果 */
+    };
+
+    /**
+     * @brief 工作线程主循环
+     */
+    void workerLoop();
+
+    /**
+     * @brief 记录一帧的结果，并按序输出所有已就绪的结果
+     */
+    void complete(std::uint64_t sequence, FrameResult &&result);
+
+    /**
+     * @brief pending 已满时扩容为两倍，须持有 orderMutex
+     *
+     * 某一帧识别特别慢时，其他工作线程会继续取帧，排在它之后的已完成结果只能等待，pending 可能超过工作线程数；
+     * 扩容只发生在这种情况下，容量达到峰值后不再分配。
+     */
+    void growPending();
+
+    const Decoder decoder;            /**< 识别函数 */
+    const Sink sink;                  /**< 结果回调 */
+    const std::size_t capacity;       /**< 队列容量，与工作线程数相同 */
+    std::vector<std::thread> threads; /**< 工作线程 */
+
+    mutable std::mutex queueMutex;      /**< 保护 queue、stopping 与 dropped */
+    std::condition_variable queueReady; /**< 有新帧或停止时通知 */
+    std::vector<Job> queue;             /**< 等待识别的帧（环形缓冲区），按序号递增 */
+    std::size_t queueHead = 0;          /**< 队首在 queue 中的下标 */
+    std::size_t queueSize = 0;          /**< 等待识别的帧数 */
+    std::uint64_t nextSequence = 0;     /**< 下一帧的采集序号 */
+    std::uint64_t dropped = 0;          /**< 被丢弃的帧数 */
+    bool stopping = false;              /**< 是否正在停止 */
+
+    std::mutex orderMutex;        /**< 保护 pending */
+    std::vector<Pending> pending; /**< 已取出、尚未输出的帧（环形缓冲区），按取出顺序排列 */
+    std::size_t pendingHead = 0;  /**< 最早取出的帧在 pending 中的下标 */
+    std::size_t pendingSize = 0;  /**< 已取出、尚未输出的帧数 */
+};
@@ -0,0 +1,63 @@
+#include "DetectorBenchmark.h"
+#include "CoarseToFineDetector.h"
+#include "FrameSource.h"
+#include <QStringList>
+#include <chrono>
+#include <opencv2/imgproc.hpp>
+
+std::vector<DetectorBenchmark::Row> DetectorBenchmark::run(const std::filesystem::path &video,
+                                                           const std::vector<std::vector<int>> &configs,
+                                                           bool luma) {
+    // 先全部读入内存，计时只包含识别本身；不按录制时的帧间隔等待，直接用 VideoFileSource 读取
+    std::vector<cv::Mat> frames;
+    VideoFileSource source(video, false);
+    for (cv::Mat frame; static_cast<int>(frames.size()) < kMaxFrames && source.read(frame);) {
+        if (frame.empty()) {
+            continue;
+        }
+        if (luma && frame.channels() != 1) {
+            cv::Mat gray;
+            cv::cvtColor(frame, gray, frame.channels() == 4 ? cv::COLOR_BGRA2GRAY : cv::COLOR_BGR2GRAY);
+            frames.push_back(std::move(gray));
+        } else {
+            frames.push_back(frame.clone());
+        }
+    }
+
+    std::vector<Row> rows;
+    for (const auto &scales : configs) {
+        const CoarseToFineDetector detector(scales);
+        Row row;
+        row.scales = detector.scales();
+        row.frames = static_cast<int>(frames.size());
+
+        const auto start = std::chrono::steady_clock::now();
+        for (const auto &frame : frames) {
+            const auto detections = detector.detect(frame);
+            row.framesWithCode += detections.empty() ? 0 : 1;
+            row.codes += static_cast<int>(detections.size());
+        }
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        row.msPerFrame = frames.empty() ? 0 : elapsed.count() / static_cast<double>(frames.size());
+        rows.push_back(row);
+    }
+    return rows;
+}
+
+QString DetectorBenchmark::toText(const std::vector<Row> &rows) {
+    QString text = QString("共 %1 帧\n\n").arg(rows.empty() ? 0 : rows.front().frames);
+    const double baseline = rows.empty() ? 0 : rows.front().msPerFrame;
+    for (const auto &row : rows) {
+        QStringList scales;
+        for (const int scale : row.scales) {
+            scales << QString("%1x").arg(scale);
+        }
+        text += QString("缩小 %1：每帧 %2 ms（%3 倍速），识别到条码的帧 %4，条码 %5 个\n")
+                    .arg(scales.join(" → "))
+                    .arg(row.msPerFrame, 0, 'f', 1)
+                    .arg(row.msPerFrame > 0 ? baseline / row.msPerFrame : 0, 0, 'f', 1)
+                    .arg(row.framesWithCode)
+                    .arg(row.codes);
+    }
+    return text;
+}
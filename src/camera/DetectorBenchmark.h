@@ -0,0 +1,44 @@
+#pragma once
+
+#include <QString>
+#include <filesystem>
+#include <vector>
+
+/**
+ * @struct DetectorBenchmark
+ * @brief 用录制的会话比较不同缩小倍数下全帧识别的耗时和识别率
+ *
+ * SessionRecorder 录制的是采集到的每一帧原始画面，没有叠加识别框，也不只保留识别到新条码的帧，
+ * 比调试保存的帧更接近识别线程实际看到的输入。
+ */
+struct DetectorBenchmark {
+    static constexpr int kMaxFrames = 600; /**< 最多读入的帧数，避免长时间的录制占满内存 */
+
+    /**
+     * @brief 一组缩小倍数的测试结果
+     */
+    struct Row {
+        std::vector<int> scales; /**< 缩小倍数 */
+        int frames = 0;          /**< 参与测试的帧数 */
+        double msPerFrame = 0;   /**< 平均每帧耗时 */
+        int framesWithCode = 0;  /**< 识别到条码的帧数 */
+        int codes = 0;           /**< 识别到的条码总数 */
+    };
+
+    /**
+     * @brief 依次用每组缩小倍数识别录制的帧（耗时较长，应在后台线程中调用）
+     * @param video 录制的会话视频
+     * @param configs 要比较的缩小倍数组合
+     * @param luma 是否像亮度模式那样只识别亮度平面
+     * @return 每组的结果；视频无法读取时帧数为 0
+     */
+    static std::vector<Row> run(const std::filesystem::path &video,
+                                const std::vector<std::vector<int>> &configs,
+                                bool luma);
+
+    /**
+     * @brief 生成可读的文本报告，以第一组结果为速度基准
+     * @param rows 测试结果
+     */
+    static QString toText(const std::vector<Row> &rows);
+};
@@ -0,0 +1,97 @@
+#include "FrameGate.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <opencv2/imgproc.hpp>
+
+FrameGate::FrameGate(const FrameGateConfig &config)
+    : analysisWidth(std::max(config.analysisWidth, 16)),
+      maxSkip(std::chrono::milliseconds(config.maxSkipMs)),
+      enabled(config.enabled),
+      minSharpness(config.minSharpness),
+      minDifference(config.minDifference) {}
+
+FrameGate::Decision FrameGate::evaluate(const cv::Mat &frame, clock::time_point timestamp) {
+    if (!enabled.load(std::memory_order_relaxed)) {
+        decoded.fetch_add(1, std::memory_order_relaxed);
+        return Decision::Decode;
+    }
+
+    // 先缩小再转灰度，两个指标都只处理几万个像素
+    const cv::Mat *input = &frame;
+    if (frame.cols > analysisWidth) {
+        const int height = std::max(1, frame.rows * analysisWidth / frame.cols);
+        cv::resize(frame, small, cv::Size(analysisWidth, height), 0, 0, cv::INTER_AREA);
+        input = &small;
+    }
+    switch (input->channels()) {
+    case 3: cv::cvtColor(*input, gray, cv::COLOR_BGR2GRAY); break;
+    case 4: cv::cvtColor(*input, gray, cv::COLOR_BGRA2GRAY); break;
+    default: input->copyTo(gray); break;
+    }
+
+    cv::Laplacian(gray, laplacian, CV_16S);
+    cv::Scalar mean, stddev;
+    cv::meanStdDev(laplacian, mean, stddev);
+    const double currentSharpness = stddev[0] * stddev[0];
+
+    double currentDifference = std::numeric_limits<double>::infinity();
+    if (reference.size() == gray.size()) {
+        cv::absdiff(gray, reference, diff);
+        currentDifference = cv::mean(diff)[0];
+    }
+    sharpness.store(currentSharpness, std::memory_order_relaxed);
+    difference.store(std::isinf(currentDifference) ? 0.0 : currentDifference, std::memory_order_relaxed);
+
+    // 静止画面只需要周期性地识别，保证跟踪中的条码不会超时
+    if (timestamp - lastDecode < maxSkip) {
+        if (currentDifference < minDifference.load(std::memory_order_relaxed)) {
+            unchanged.fetch_add(1, std::memory_order_relaxed);
+            return Decision::Unchanged;
+        }
+        if (currentSharpness < minSharpness.load(std::memory_order_relaxed)) {
+            blurry.fetch_add(1, std::memory_order_relaxed);
+            return Decision::Blurry;
+        }
+    }
+
+    std::swap(reference, gray);
+    lastDecode = timestamp;
+    decoded.fetch_add(1, std::memory_order_relaxed);
+    return Decision::Decode;
+}
+
+void FrameGate::setEnabled(bool value) {
+    enabled.store(value, std::memory_order_relaxed);
+}
+
+bool FrameGate::isEnabled() const {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+void FrameGate::setThresholds(double sharpnessThreshold, double differenceThreshold) {
+    minSharpness.store(std::max(sharpnessThreshold, 0.0), std::memory_order_relaxed);
+    minDifference.store(std::max(differenceThreshold, 0.0), std::memory_order_relaxed);
+}
+
+FrameGate::Stats FrameGate::stats() const {
+    Stats stats;
+    stats.sharpness = sharpness.load(std::memory_order_relaxed);
+    stats.difference = difference.load(std::memory_order_relaxed);
+    stats.minSharpness = minSharpness.load(std::memory_order_relaxed);
+    stats.minDifference = minDifference.load(std::memory_order_relaxed);
+    stats.decoded = decoded.load(std::memory_order_relaxed);
+    stats.blurry = blurry.load(std::memory_order_relaxed);
+    stats.unchanged = unchanged.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void FrameGate::reset() {
+    reference.release();
+    lastDecode = {};
+    sharpness.store(0, std::memory_order_relaxed);
+    difference.store(0, std::memory_order_relaxed);
+    decoded.store(0, std::memory_order_relaxed);
+    blurry.store(0, std::memory_order_relaxed);
+    unchanged.store(0, std::memory_order_relaxed);
+}
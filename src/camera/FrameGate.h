@@ -0,0 +1,99 @@
+#pragma once
+
+#include "ScanConfig.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <opencv2/core.hpp>
+
+/**
+ * @class FrameGate
+ * @brief 在提交识别之前跳过模糊或画面静止的帧
+ *
+ * 识别一帧要做完整的 ReadBarcodes，而运动中的模糊帧基本无法识别，静止画面的识别结果又与上一次相同。
+ * FrameGate 把帧缩小到很小的宽度并转为灰度，计算两个廉价指标：拉普拉斯方差（清晰度），
+ * 以及与上次提交识别的帧之间的平均灰度差（帧差）。清晰度或帧差低于门限时不提交识别；
+ * 连续跳过超过 maxSkipMs 时强制识别一帧，保证条码跟踪不会因为画面静止而超时。
+ * evaluate() 只在采集线程中调用，门限和统计可在任意线程读写。
+ */
+class FrameGate {
+public:
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * @brief 对一帧的判定
+     */
+    enum class Decision {
+        Decode,    /**< 提交识别 */
+        Blurry,    /**< 模糊，跳过 */
+        Unchanged, /**< 与上次识别的帧相比没有变化，跳过 */
+    };
+
+    /**
+     * @brief 指标和计数的快照
+     */
+    struct Stats {
+        double sharpness = 0;        /**< 最近一帧的清晰度（拉普拉斯方差） */
+        double difference = 0;       /**< 最近一帧与上次识别的帧的平均灰度差 */
+        double minSharpness = 0;     /**< 清晰度门限 */
+        double minDifference = 0;    /**< 帧差门限 */
+        std::uint64_t decoded = 0;   /**< 提交识别的帧数 */
+        std::uint64_t blurry = 0;    /**< 因模糊跳过的帧数 */
+        std::uint64_t unchanged = 0; /**< 因画面静止跳过的帧数 */
+    };
+
+    /**
+     * @param config 门限参数
+     */
+    explicit FrameGate(const FrameGateConfig &config);
+
+    /**
+     * @brief 判定一帧是否需要识别（只在采集线程中调用）
+     * @param frame BGR / BGRA / 灰度图
+     * @param timestamp 采集时间
+     */
+    Decision evaluate(const cv::Mat &frame, clock::time_point timestamp);
+
+    /**
+     * @brief 是否启用；未启用时所有帧都提交识别，也不计算指标
+     */
+    void setEnabled(bool enabled);
+
+    bool isEnabled() const;
+
+    /**
+     * @brief 修改门限，从下一帧开始生效
+     * @param minSharpness 清晰度门限
+     * @param minDifference 帧差门限
+     */
+    void setThresholds(double minSharpness, double minDifference);
+
+    /**
+     * @brief 当前指标和计数
+     */
+    Stats stats() const;
+
+    /**
+     * @brief 清除参考帧和计数，须在采集线程停止后调用
+     */
+    void reset();
+
+private:
+    const int analysisWidth;                 /**< 计算指标时的图像宽度 */
+    const clock::duration maxSkip;           /**< 连续跳过的最长时间 */
+    std::atomic_bool enabled;                /**< 是否启用 */
+    std::atomic<double> minSharpness;        /**< 清晰度门限 */
+    std::atomic<double> minDifference;       /**< 帧差门限 */
+    std::atomic<double> sharpness{0};        /**< 最近一帧的清晰度 */
+    std::atomic<double> difference{0};       /**< 最近一帧的帧差 */
+    std::atomic<std::uint64_t> decoded{0};   /**< 提交识别的帧数 */
+    std::atomic<std::uint64_t> blurry{0};    /**< 因模糊跳过的帧数 */
+    std::atomic<std::uint64_t> unchanged{0}; /**< 因画面静止跳过的帧数 */
+
+    cv::Mat small;                /**< 缩小后的帧 */
+    cv::Mat gray;                 /**< 缩小后的灰度图 */
+    cv::Mat laplacian;            /**< 拉普拉斯响应 */
+    cv::Mat diff;                 /**< 与参考帧的差 */
+    cv::Mat reference;            /**< 上次提交识别的帧（缩小后的灰度图） */
+    clock::time_point lastDecode; /**< 上次提交识别的时间 */
+};
@@ -0,0 +1,54 @@
+#include "FramePacer.h"
+#include <algorithm>
+#include <thread>
+
+namespace {
+
+constexpr double kDefaultFps = 30.0;       /**< 摄像头未报告帧率时的估计值 */
+constexpr double kMaxFps = 240.0;          /**< 超过该值的帧率视为无效 */
+constexpr double kNonBlockingRatio = 0.25; /**< 读帧阻塞时间低于帧间隔的该比例时，视为读帧不阻塞 */
+constexpr double kSmoothing = 0.1;         /**< 滑动平均系数 */
+constexpr int kMaxBackoffShift = 3;        /**< 空帧退避最长 2^3 = 8 个帧间隔 */
+
+std::chrono::steady_clock::duration intervalOf(double fps) {
+    if (!(fps > 0 && fps <= kMaxFps)) {
+        fps = kDefaultFps;
+    }
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / fps));
+}
+
+} // namespace
+
+FramePacer::FramePacer(double fps)
+    : interval(intervalOf(fps)), grabStart(clock::now()), lastFrame(grabStart) {}
+
+void FramePacer::waitForFrame() {
+    if (blockingRatio < kNonBlockingRatio) {
+        std::this_thread::sleep_until(lastFrame + interval);
+    }
+    grabStart = clock::now();
+}
+
+void FramePacer::frameReceived(bool gotFrame) {
+    const auto now = clock::now();
+    if (!gotFrame) {
+        std::this_thread::sleep_for(interval * (1 << std::min(emptyStreak, kMaxBackoffShift)));
+        ++emptyStreak;
+        return;
+    }
+    emptyStreak = 0;
+
+    const double blocked = std::chrono::duration<double>(now - grabStart) / interval;
+    blockingRatio += kSmoothing * (std::min(blocked, 1.0) - blockingRatio);
+
+    const double seconds = std::chrono::duration<double>(now - lastFrame).count();
+    if (seconds > 0) {
+        const double instant = 1.0 / seconds;
+        fps = fps > 0 ? fps + kSmoothing * (instant - fps) : instant;
+    }
+    lastFrame = now;
+}
+
+double FramePacer::measuredFps() const {
+    return fps;
+}
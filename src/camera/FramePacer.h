@@ -0,0 +1,45 @@
+#pragma once
+
+#include <chrono>
+
+/**
+ * @class FramePacer
+ * @brief 按摄像头的帧间隔调度采集循环，取代固定的 sleep
+ *
+ * 多数后端的读帧调用会阻塞到下一帧到达，此时不需要额外等待；少数后端（或驱动重复返回同一帧时）
+ * 读帧立即返回，采集循环会空转占满一个核心。FramePacer 统计读帧调用的阻塞时间，
+ * 只有读帧不阻塞时才等到下一帧的预期时间；读到空帧时按帧间隔指数退避，最长 8 个帧间隔。
+ */
+class FramePacer {
+public:
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * @param fps 摄像头报告的帧率，无效时按 30 帧估计
+     */
+    explicit FramePacer(double fps);
+
+    /**
+     * @brief 读帧之前调用，必要时等待到下一帧的预期时间
+     */
+    void waitForFrame();
+
+    /**
+     * @brief 读帧之后调用
+     * @param gotFrame 是否读到了帧；读到空帧时按退避时间等待
+     */
+    void frameReceived(bool gotFrame);
+
+    /**
+     * @brief 实测帧率（指数滑动平均）
+     */
+    double measuredFps() const;
+
+private:
+    const clock::duration interval; /**< 标称帧间隔 */
+    clock::time_point grabStart;    /**< 本次读帧开始时间 */
+    clock::time_point lastFrame;    /**< 上一帧到达时间 */
+    double blockingRatio = 1.0;     /**< 读帧阻塞时间占帧间隔比例的滑动平均 */
+    int emptyStreak = 0;            /**< 连续空帧数 */
+    double fps = 0.0;               /**< 实测帧率 */
+};
@@ -0,0 +1,38 @@
+#include "FramePool.h"
+#include <algorithm>
+#include <atomic>
+
+namespace {
+
+/**
+ * @brief 缓冲区是否空闲：尚未分配，或只剩池自己持有的引用
+ */
+bool isFree(cv::Mat &buffer) {
+    if (!buffer.u) {
+        return true;
+    }
+    // 引用计数由其他线程用原子操作递减
+    return std::atomic_ref<int>(buffer.u->refcount).load(std::memory_order_acquire) == 1;
+}
+
+} // namespace
+
+FramePool::FramePool(std::size_t capacity)
+    : buffers(std::max<std::size_t>(capacity, 1)) {}
+
+cv::Mat &FramePool::acquire() {
+    for (std::size_t i = 0; i < buffers.size(); ++i) {
+        auto &buffer = buffers[(next + i) % buffers.size()];
+        if (isFree(buffer)) {
+            next = (next + i + 1) % buffers.size();
+            return buffer;
+        }
+    }
+    ++misses;
+    overflow.release();
+    return overflow;
+}
+
+std::uint64_t FramePool::missCount() const {
+    return misses;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <opencv2/core.hpp>
+#include <vector>
+
+/**
+ * @class FramePool
+ * @brief 采集线程复用的视频帧缓冲区环
+ *
+ * 每次读帧都新建 cv::Mat 时，每帧都要分配和释放一整帧的内存。FramePool 持有固定数量的缓冲区，
+ * 采集线程取一个空闲的缓冲区直接读入，再把 Mat 头拷贝给识别线程和预览作为租约：
+ * cv::Mat 自带的引用计数就是租约计数，所有拷贝都释放后引用计数回到 1，缓冲区重新变为空闲。
+ * 后端读帧时尺寸和类型不变就会复用已有的内存，因此前几帧分配之后，稳定运行时不再分配。
+ * 只能在一个线程（采集线程）中调用 acquire()。
+ */
+class FramePool {
+public:
+    /**
+     * @param capacity 缓冲区数量，应不少于同时在途的帧数（识别队列、识别线程、待显示的帧）
+     */
+    explicit FramePool(std::size_t capacity);
+
+    /**
+     * @brief 取一个空闲的缓冲区
+     *
+     * 调用方直接向返回的 Mat 读入帧，再拷贝 Mat 头传给其他线程。
+     * 所有缓冲区都在使用中时返回一个已释放的备用 Mat（读帧时会新分配），并计入 missCount()。
+     */
+    cv::Mat &acquire();
+
+    /**
+     * @brief 缓冲区耗尽、只能新分配的次数
+     */
+    std::uint64_t missCount() const;
+
+private:
+    std::vector<cv::Mat> buffers; /**< 缓冲区环 */
+    std::size_t next = 0;         /**< 下一次开始查找的位置 */
+    cv::Mat overflow;             /**< 缓冲区耗尽时使用的备用 Mat */
+    std::uint64_t misses = 0;     /**< 缓冲区耗尽的次数 */
+};
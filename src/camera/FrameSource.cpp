@@ -0,0 +1,225 @@
+#include "FrameSource.h"
+#include <algorithm>
+#include <cctype>
+#include <format>
+#include <fstream>
+#include <opencv2/imgcodecs.hpp>
+#include <spdlog/spdlog.h>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+/**
+ * @brief 是否为图片目录播放支持的扩展名
+ */
+bool isImageFile(const std::filesystem::path &path) {
+    auto ext = path.extension().string();
+    std::ranges::transform(ext, ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".bmp" || ext == ".tif" || ext == ".tiff";
+}
+
+/**
+ * @brief 把整个文件读入 bytes，缓冲区容量只增不减
+ */
+bool readFile(const std::filesystem::path &path, std::vector<uchar> &bytes) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+    bytes.resize(static_cast<std::size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(file);
+}
+
+} // namespace
+
+bool FrameSource::finished() const {
+    return false;
+}
+
+bool FrameSource::configure(int, int, double) {
+    return false;
+}
+
+CameraSource::CameraSource(int index)
+    : index(index), capture(index) {}
+
+bool CameraSource::isOpened() const {
+    return capture.isOpened();
+}
+
+bool CameraSource::read(cv::Mat &frame) {
+    return capture.read(frame);
+}
+
+double CameraSource::fps() const {
+    return capture.get(cv::CAP_PROP_FPS);
+}
+
+cv::Size CameraSource::frameSize() const {
+    return {static_cast<int>(capture.get(cv::CAP_PROP_FRAME_WIDTH)),
+            static_cast<int>(capture.get(cv::CAP_PROP_FRAME_HEIGHT))};
+}
+
+bool CameraSource::configure(int width, int height, double fps) {
+    const bool okWidth = capture.set(cv::CAP_PROP_FRAME_WIDTH, width);
+    const bool okHeight = capture.set(cv::CAP_PROP_FRAME_HEIGHT, height);
+    const bool okFps = capture.set(cv::CAP_PROP_FPS, fps);
+    spdlog::info("Set width={}, ok={}", width, okWidth);
+    spdlog::info("Set height={}, ok={}", height, okHeight);
+    spdlog::info("Set fps={}, ok={}", fps, okFps);
+    return okWidth && okHeight && okFps;
+}
+
+std::string CameraSource::description() const {
+    return std::format("摄像头 {}", index);
+}
+
+VideoFileSource::VideoFileSource(std::filesystem::path path, bool loop)
+    : path(std::move(path)), loop(loop), capture(this->path.string()) {}
+
+bool VideoFileSource::isOpened() const {
+    return capture.isOpened();
+}
+
+bool VideoFileSource::read(cv::Mat &frame) {
+    if (ended) {
+        return false;
+    }
+    if (capture.read(frame)) {
+        ++framesRead;
+        return true;
+    }
+    // 读到结尾：循环时回到第一帧；一帧都没读到说明文件无法解码，不再重试
+    if (loop && framesRead > 0) {
+        capture.set(cv::CAP_PROP_POS_FRAMES, 0);
+        framesRead = 0;
+        if (capture.read(frame)) {
+            ++framesRead;
+            return true;
+        }
+    }
+    ended = true;
+    return false;
+}
+
+bool VideoFileSource::finished() const {
+    return ended;
+}
+
+double VideoFileSource::fps() const {
+    return capture.get(cv::CAP_PROP_FPS);
+}
+
+cv::Size VideoFileSource::frameSize() const {
+    return {static_cast<int>(capture.get(cv::CAP_PROP_FRAME_WIDTH)),
+            static_cast<int>(capture.get(cv::CAP_PROP_FRAME_HEIGHT))};
+}
+
+std::string VideoFileSource::description() const {
+    return std::format("视频 {}", path.filename().string());
+}
+
+std::int64_t VideoFileSource::position() const {
+    return framesRead - 1;
+}
+
+ImageDirectorySource::ImageDirectorySource(std::filesystem::path directory, double fps, bool loop)
+    : directory(std::move(directory)), frameRate(fps), loop(loop) {
+    std::error_code ec;
+    for (const auto &entry : std::filesystem::directory_iterator(this->directory, ec)) {
+        if (entry.is_regular_file(ec) && isImageFile(entry.path())) {
+            files.push_back(entry.path());
+        }
+    }
+    std::ranges::sort(files);
+    if (!files.empty()) {
+        size = cv::imread(files.front().string()).size();
+    }
+}
+
+bool ImageDirectorySource::isOpened() const {
+    return !files.empty();
+}
+
+bool ImageDirectorySource::read(cv::Mat &frame) {
+    // 无法解码的图片直接跳过，最多尝试一整轮
+    for (std::size_t attempts = 0; attempts < files.size() && !ended; ++attempts) {
+        if (next == files.size()) {
+            if (!loop) {
+                ended = true;
+                break;
+            }
+            next = 0;
+        }
+        const auto &file = files[next++];
+        // 解码到 frame 本身，尺寸和类型不变时复用缓冲区
+        if (readFile(file, bytes) && !cv::imdecode(bytes, cv::IMREAD_COLOR, &frame).empty()) {
+            return true;
+        }
+        spdlog::warn("无法读取图片: {}", file.string());
+    }
+    return false;
+}
+
+bool ImageDirectorySource::finished() const {
+    return ended;
+}
+
+double ImageDirectorySource::fps() const {
+    return frameRate;
+}
+
+cv::Size ImageDirectorySource::frameSize() const {
+    return size;
+}
+
+std::string ImageDirectorySource::description() const {
+    return std::format("图片目录 {}（{} 张）", directory.filename().string(), files.size());
+}
+
+RecordedSessionSource::RecordedSessionSource(std::filesystem::path path, bool loop)
+    : VideoFileSource(std::move(path), loop) {
+    std::ifstream file(timestampPath(this->path));
+    std::string line;
+    std::getline(file, line); // 表头
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        std::int64_t index = 0;
+        char comma = 0;
+        double ms = 0;
+        if (fields >> index >> comma >> ms) {
+            const std::chrono::duration<double, std::milli> offset(ms);
+            offsets.push_back(std::chrono::duration_cast<clock::duration>(offset));
+        }
+    }
+    if (offsets.empty()) {
+        spdlog::warn("未找到录制时间戳 {}，按标称帧率回放", timestampPath(this->path).string());
+    }
+}
+
+bool RecordedSessionSource::read(cv::Mat &frame) {
+    if (!VideoFileSource::read(frame)) {
+        return false;
+    }
+    // 等到该帧在录制时的相对时刻再送出；每轮回放的第一帧重新对齐起点
+    const auto index = position();
+    if (index < static_cast<std::int64_t>(offsets.size())) {
+        if (index == 0) {
+            start = clock::now() - offsets.front();
+        }
+        std::this_thread::sleep_until(start + offsets[index]);
+    }
+    return true;
+}
+
+std::string RecordedSessionSource::description() const {
+    return std::format("回放 {}", path.filename().string());
+}
+
+std::filesystem::path RecordedSessionSource::timestampPath(const std::filesystem::path &video) {
+    auto csv = video;
+    return csv.replace_extension(".csv");
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <opencv2/core.hpp>
+#include <opencv2/videoio.hpp>
+#include <string>
+#include <vector>
+
+/**
+ * @class FrameSource
+ * @brief 扫描流水线的帧来源：摄像头、视频文件、图片目录或录制的会话
+ *
+ * 采集线程只通过这个接口读帧，没有摄像头的机器也可以用视频文件或录制的会话运行整条流水线并测量性能。
+ * read() 只在采集线程中调用；文件类来源读完后 finished() 返回 true，开启循环播放时从头重新开始。
+ */
+class FrameSource {
+public:
+    virtual ~FrameSource() = default;
+
+    /**
+     * @brief 是否已成功打开
+     */
+    virtual bool isOpened() const = 0;
+
+    /**
+     * @brief 读入下一帧
+     * @param frame 输出缓冲区，尺寸和类型不变时复用
+     * @return 是否读到了帧
+     */
+    virtual bool read(cv::Mat &frame) = 0;
+
+    /**
+     * @brief 不循环的文件类来源是否已经读完
+     */
+    virtual bool finished() const;
+
+    /**
+     * @brief 标称帧率，未知时返回 0
+     */
+    virtual double fps() const = 0;
+
+    /**
+     * @brief 帧尺寸，未知时为空
+     */
+    virtual cv::Size frameSize() const = 0;
+
+    /**
+     * @brief 设置分辨率和帧率，只有摄像头支持
+     * @return 是否全部设置成功
+     */
+    virtual bool configure(int width, int height, double fps);
+
+    /**
+     * @brief 用于日志和状态栏的描述
+     */
+    virtual std::string description() const = 0;
+};
+
+/**
+ * @class CameraSource
+ * @brief 实时摄像头
+ */
+class CameraSource : public FrameSource {
+public:
+    /**
+     * @param index 摄像头设备索引
+     */
+    explicit CameraSource(int index);
+
+    bool isOpened() const override;
+    bool read(cv::Mat &frame) override;
+    double fps() const override;
+    cv::Size frameSize() const override;
+    bool configure(int width, int height, double fps) override;
+    std::string description() const override;
+
+private:
+    const int index;          /**< 摄像头设备索引 */
+    cv::VideoCapture capture; /**< 摄像头 */
+};
+
+/**
+ * @class VideoFileSource
+ * @brief cv::VideoCapture 能读取的任意视频文件，读帧不等待，由 FramePacer 按标称帧率调度
+ */
+class VideoFileSource : public FrameSource {
+public:
+    /**
+     * @param path 视频文件路径
+     * @param loop 读完后是否从头循环播放
+     */
+    VideoFileSource(std::filesystem::path path, bool loop);
+
+    bool isOpened() const override;
+    bool read(cv::Mat &frame) override;
+    bool finished() const override;
+    double fps() const override;
+    cv::Size frameSize() const override;
+    std::string description() const override;
+
+protected:
+    /**
+     * @brief 本轮播放中刚读到的帧的序号（从 0 开始），循环回到开头时重新计数
+     */
+    std::int64_t position() const;
+
+    const std::filesystem::path path; /**< 视频文件路径 */
+
+private:
+    const bool loop;             /**< 是否循环播放 */
+    cv::VideoCapture capture;    /**< 视频文件 */
+    std::int64_t framesRead = 0; /**< 本轮播放已读的帧数 */
+    bool ended = false;          /**< 是否已读完 */
+};
+
+/**
+ * @class ImageDirectorySource
+ * @brief 按文件名顺序播放目录中的图片（如调试保存的帧），以固定帧率调度
+ */
+class ImageDirectorySource : public FrameSource {
+public:
+    /**
+     * @param directory 图片目录
+     * @param fps 播放帧率
+     * @param loop 播放完后是否从头循环
+     */
+    ImageDirectorySource(std::filesystem::path directory, double fps, bool loop);
+
+    bool isOpened() const override;
+    bool read(cv::Mat &frame) override;
+    bool finished() const override;
+    double fps() const override;
+    cv::Size frameSize() const override;
+    std::string description() const override;
+
+private:
+    const std::filesystem::path directory;    /**< 图片目录 */
+    const double frameRate;                   /**< 播放帧率 */
+    const bool loop;                          /**< 是否循环播放 */
+    std::vector<std::filesystem::path> files; /**< 按文件名排序的图片 */
+    std::size_t next = 0;                     /**< 下一张图片的下标 */
+    std::vector<uchar> bytes;                 /**< 文件内容缓冲区，按需增长后复用 */
+    cv::Size size;                            /**< 第一张图片的尺寸 */
+    bool ended = false;                       /**< 是否已播放完 */
+};
+
+/**
+ * @class RecordedSessionSource
+ * @brief 回放 SessionRecorder 录制的会话：按录制时的时间戳送出每一帧，重现现场的帧间隔
+ *
+ * 时间戳文件与视频同名、扩展名为 .csv；缺失时退化为按标称帧率播放的普通视频文件。
+ */
+class RecordedSessionSource : public VideoFileSource {
+public:
+    /**
+     * @param path 录制的视频文件路径
+     * @param loop 读完后是否从头循环播放
+     */
+    RecordedSessionSource(std::filesystem::path path, bool loop);
+
+    bool read(cv::Mat &frame) override;
+    std::string description() const override;
+
+    /**
+     * @brief 时间戳文件路径
+     * @param video 录制的视频文件路径
+     */
+    static std::filesystem::path timestampPath(const std::filesystem::path &video);
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    std::vector<clock::duration> offsets; /**< 各帧相对第一帧的时间 */
+    clock::time_point start;              /**< 本轮回放中第一帧对应的时刻 */
+};
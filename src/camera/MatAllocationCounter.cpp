@@ -0,0 +1,40 @@
+#include "MatAllocationCounter.h"
+
+MatAllocationCounter::MatAllocationCounter(cv::MatAllocator *base)
+    : base(base) {}
+
+MatAllocationCounter &MatAllocationCounter::install() {
+    static MatAllocationCounter *instance = [] {
+        auto *counter = new MatAllocationCounter(cv::Mat::getDefaultAllocator());
+        cv::Mat::setDefaultAllocator(counter);
+        return counter;
+    }();
+    return *instance;
+}
+
+std::uint64_t MatAllocationCounter::count() const {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+cv::UMatData *MatAllocationCounter::allocate(int dims,
+                                             const int *sizes,
+                                             int type,
+                                             void *data,
+                                             size_t *step,
+                                             cv::AccessFlag flags,
+                                             cv::UMatUsageFlags usageFlags) const {
+    if (!data) {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    return base->allocate(dims, sizes, type, data, step, flags, usageFlags);
+}
+
+bool MatAllocationCounter::allocate(cv::UMatData *data,
+                                    cv::AccessFlag accessflags,
+                                    cv::UMatUsageFlags usageFlags) const {
+    return base->allocate(data, accessflags, usageFlags);
+}
+
+void MatAllocationCounter::deallocate(cv::UMatData *data) const {
+    base->deallocate(data);
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <opencv2/core.hpp>
+
+/**
+ * @class MatAllocationCounter
+ * @brief 统计 cv::Mat 内存分配次数的分配器，用于验证扫描过程中每帧不再分配帧缓冲区
+ *
+ * 安装为 OpenCV 的默认分配器，所有请求转发给原来的默认分配器，只额外计数；
+ * 实际的内存由原分配器持有和释放，因此安装后不能、也不需要卸载。
+ */
+class MatAllocationCounter : public cv::MatAllocator {
+public:
+    /**
+     * @brief 安装为默认分配器（只在第一次调用时安装），返回全局实例
+     */
+    static MatAllocationCounter &install();
+
+    /**
+     * @brief 安装以来 cv::Mat 分配内存的次数
+     */
+    std::uint64_t count() const;
+
+    cv::UMatData *allocate(int dims,
+                           const int *sizes,
+                           int type,
+                           void *data,
+                           size_t *step,
+                           cv::AccessFlag flags,
+                           cv::UMatUsageFlags usageFlags) const override;
+
+    bool allocate(cv::UMatData *data, cv::AccessFlag accessflags, cv::UMatUsageFlags usageFlags) const override;
+
+    void deallocate(cv::UMatData *data) const override;
+
+private:
+    explicit MatAllocationCounter(cv::MatAllocator *base);
+
+    cv::MatAllocator *const base;                      /**< 原来的默认分配器 */
+    mutable std::atomic<std::uint64_t> allocations{0}; /**< 分配次数 */
+};
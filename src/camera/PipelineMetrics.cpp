@@ -0,0 +1,173 @@
+#include "PipelineMetrics.h"
+#include <QStringList>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace {
+
+/**
+ * @brief 微秒数所在的桶：按最高位分组，再取其后 2 位细分
+ */
+int bucketOf(std::uint64_t us) {
+    if (us < 4) {
+        return static_cast<int>(us); // 0-3µs 各占一个桶
+    }
+    const int octave = std::bit_width(us) - 1;
+    const int sub = static_cast<int>((us >> (octave - 2)) & 3);
+    return std::min(octave * 4 + sub, LatencyHistogram::kBuckets - 1);
+}
+
+/**
+ * @brief 桶所覆盖区间的中点（微秒）
+ */
+double bucketMidUs(int bucket) {
+    if (bucket < 8) {
+        return bucket; // 0-3 号桶各对应 1µs，4-7 号桶不使用
+    }
+    const int octave = bucket / 4;
+    const int sub = bucket % 4;
+    const double width = std::ldexp(1.0, octave - 2);
+    return (4 + sub) * width + width / 2;
+}
+
+std::uint64_t toUs(std::chrono::steady_clock::duration elapsed) {
+    const auto us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    return us > 0 ? static_cast<std::uint64_t>(us) : 0;
+}
+
+} // namespace
+
+void LatencyHistogram::record(std::chrono::steady_clock::duration elapsed) {
+    buckets[bucketOf(toUs(elapsed))].fetch_add(1, std::memory_order_relaxed);
+}
+
+LatencyHistogram::Counts LatencyHistogram::snapshot() const {
+    Counts counts{};
+    for (int i = 0; i < kBuckets; ++i) {
+        counts[i] = buckets[i].load(std::memory_order_relaxed);
+    }
+    return counts;
+}
+
+double LatencyHistogram::percentileMs(const Counts &counts, double p) {
+    std::uint64_t total = 0;
+    for (const auto count : counts) {
+        total += count;
+    }
+    if (total == 0) {
+        return 0;
+    }
+    // 最近秩法，与批处理报告的分位数口径一致
+    const auto rank = std::max<std::uint64_t>(static_cast<std::uint64_t>(std::ceil(p * static_cast<double>(total))), 1);
+    std::uint64_t seen = 0;
+    for (int i = 0; i < kBuckets; ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return bucketMidUs(i) / 1000.0;
+        }
+    }
+    return bucketMidUs(kBuckets - 1) / 1000.0;
+}
+
+PipelineMetrics::StageTimer::StageTimer(PipelineMetrics &metrics, PipelineStage stage)
+    : metrics(metrics), stage(stage), start(clock::now()) {}
+
+PipelineMetrics::StageTimer::~StageTimer() {
+    metrics.addStageTime(stage, clock::now() - start);
+}
+
+void PipelineMetrics::frameCaptured() {
+    captured.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PipelineMetrics::frameDecoded(clock::duration elapsed) {
+    decoded.fetch_add(1, std::memory_order_relaxed);
+    decodeLatency.record(elapsed);
+}
+
+void PipelineMetrics::resultShown(clock::duration latency) {
+    resultLatency.record(latency);
+}
+
+void PipelineMetrics::addStageTime(PipelineStage stage, clock::duration elapsed) {
+    const auto s = static_cast<int>(stage);
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    stageNs[s].fetch_add(ns > 0 ? static_cast<std::uint64_t>(ns) : 0, std::memory_order_relaxed);
+    stageRuns[s].fetch_add(1, std::memory_order_relaxed);
+}
+
+PipelineMetrics::Snapshot PipelineMetrics::snapshot() const {
+    Snapshot snapshot;
+    snapshot.time = clock::now();
+    snapshot.captured = captured.load(std::memory_order_relaxed);
+    snapshot.decoded = decoded.load(std::memory_order_relaxed);
+    snapshot.decodeLatency = decodeLatency.snapshot();
+    snapshot.resultLatency = resultLatency.snapshot();
+    for (int s = 0; s < kStageCount; ++s) {
+        snapshot.stageNs[s] = stageNs[s].load(std::memory_order_relaxed);
+        snapshot.stageRuns[s] = stageRuns[s].load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+PipelineMetrics::Report PipelineMetrics::compare(const Snapshot &previous, const Snapshot &current) {
+    Report report;
+    report.seconds = std::chrono::duration<double>(current.time - previous.time).count();
+    if (report.seconds <= 0) {
+        return report;
+    }
+    report.captureFps = static_cast<double>(current.captured - previous.captured) / report.seconds;
+    report.decodeFps = static_cast<double>(current.decoded - previous.decoded) / report.seconds;
+
+    // 各计数器不是同一时刻读取的，相减时按 0 截断，避免个别桶出现负数
+    const auto delta = [](const LatencyHistogram::Counts &a, const LatencyHistogram::Counts &b) {
+        LatencyHistogram::Counts counts{};
+        for (int i = 0; i < LatencyHistogram::kBuckets; ++i) {
+            counts[i] = b[i] > a[i] ? b[i] - a[i] : 0;
+        }
+        return counts;
+    };
+    const auto decodeCounts = delta(previous.decodeLatency, current.decodeLatency);
+    const auto resultCounts = delta(previous.resultLatency, current.resultLatency);
+    report.decodeP50Ms = LatencyHistogram::percentileMs(decodeCounts, 0.50);
+    report.decodeP95Ms = LatencyHistogram::percentileMs(decodeCounts, 0.95);
+    report.resultP50Ms = LatencyHistogram::percentileMs(resultCounts, 0.50);
+    report.resultP95Ms = LatencyHistogram::percentileMs(resultCounts, 0.95);
+
+    for (int s = 0; s < kStageCount; ++s) {
+        const double ms = static_cast<double>(current.stageNs[s] - previous.stageNs[s]) / 1e6;
+        const auto runs = current.stageRuns[s] - previous.stageRuns[s];
+        report.stageMs[s] = runs > 0 ? ms / static_cast<double>(runs) : 0;
+        report.stageLoad[s] = ms / 1000.0 / report.seconds;
+    }
+    return report;
+}
+
+QString PipelineMetrics::stageName(PipelineStage stage) {
+    switch (stage) {
+    case PipelineStage::Gate: return "跳帧判定";
+    case PipelineStage::Luma: return "亮度提取";
+    case PipelineStage::Preview: return "预览";
+    case PipelineStage::Detect: return "识别";
+    case PipelineStage::Rectify: return "矫正编码";
+    case PipelineStage::Ui: return "界面更新";
+    default: return {};
+    }
+}
+
+QString PipelineMetrics::Report::toText() const {
+    QStringList lines;
+    lines << QString("采集 %1 FPS，识别 %2 FPS").arg(captureFps, 0, 'f', 1).arg(decodeFps, 0, 'f', 1);
+    lines << QString("识别耗时 p50 %1 ms，p95 %2 ms").arg(decodeP50Ms, 0, 'f', 1).arg(decodeP95Ms, 0, 'f', 1);
+    lines << QString("采集到显示 p50 %1 ms，p95 %2 ms").arg(resultP50Ms, 0, 'f', 1).arg(resultP95Ms, 0, 'f', 1);
+    for (int s = 0; s < kStageCount; ++s) {
+        if (stageMs[s] > 0) {
+            lines << QString("%1 %2 ms/次，%3 核")
+                         .arg(stageName(static_cast<PipelineStage>(s)))
+                         .arg(stageMs[s], 0, 'f', 2)
+                         .arg(stageLoad[s], 0, 'f', 2);
+        }
+    }
+    return lines.join('\n');
+}
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <QString>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief 摄像头流水线中分别计时的阶段
+ */
+enum class PipelineStage {
+    Gate,    /**< 模糊与静止判定（采集线程） */
+    Luma,    /**< 提取亮度平面（采集线程） */
+    Preview, /**< 预览缩放与颜色转换（采集线程） */
+    Detect,  /**< 条码识别（识别线程） */
+    Rectify, /**< 新条码的矫正、增强与 PNG 编码（识别线程） */
+    Ui,      /**< 更新叠加层和结果表格（界面线程） */
+    Count,
+};
+
+/**
+ * @class LatencyHistogram
+ * @brief 无锁的耗时直方图，用于估算分位数
+ *
+ * 以微秒为单位按 2 的幂分组，每组再细分为 4 个桶，相对误差约 ±10%；覆盖 1µs 到约 35 分钟。
+ * record() 只做一次原子加，可在任意线程中并发调用；snapshot() 得到的计数可以相减，得到一段时间内的分布。
+ */
+class LatencyHistogram {
+public:
+    static constexpr int kBuckets = 128;
+    using Counts = std::array<std::uint64_t, kBuckets>;
+
+    /**
+     * @brief 记录一次耗时
+     */
+    void record(std::chrono::steady_clock::duration elapsed);
+
+    /**
+     * @brief 当前各桶的累计计数
+     */
+    Counts snapshot() const;
+
+    /**
+     * @brief 估算分位数
+     * @param counts 各桶计数（可以是两次快照之差）
+     * @param p 分位（0-1）
+     * @return 毫秒，没有数据时返回 0
+     */
+    static double percentileMs(const Counts &counts, double p);
+
+private:
+    std::array<std::atomic<std::uint64_t>, kBuckets> buckets{}; /**< 各桶计数 */
+};
+
+/**
+ * @class PipelineMetrics
+ * @brief 摄像头流水线的实时性能指标
+ *
+ * 采集、识别和界面线程只对计数器和直方图做原子加，不加锁、不分配内存。
+ * 界面线程定时取快照，用相邻两次快照之差计算这段时间内的帧率、分位数和各阶段耗时。
+ * 各阶段记录的是所在线程上的实际耗时（steady_clock），不含等待帧和排队的时间。
+ */
+class PipelineMetrics {
+public:
+    using clock = std::chrono::steady_clock;
+    static constexpr int kStageCount = static_cast<int>(PipelineStage::Count);
+
+    /**
+     * @class StageTimer
+     * @brief 对所在作用域内的一个阶段计时（RAII）
+     */
+    class StageTimer {
+    public:
+        StageTimer(PipelineMetrics &metrics, PipelineStage stage);
+
+        ~StageTimer();
+
+        StageTimer(const StageTimer &) = delete;
+        StageTimer &operator=(const StageTimer &) = delete;
+
+    private:
+        PipelineMetrics &metrics; /**< 所属的指标 */
+        PipelineStage stage;      /**< 阶段 */
+        clock::time_point start;  /**< 开始时间 */
+    };
+
+    /**
+     * @brief 某一时刻的累计值
+     */
+    struct Snapshot {
+        clock::time_point time;                             /**< 取快照的时间 */
+        std::uint64_t captured = 0;                         /**< 采集的帧数 */
+        std::uint64_t decoded = 0;                          /**< 识别完成的帧数 */
+        LatencyHistogram::Counts decodeLatency{};           /**< 识别耗时分布 */
+        LatencyHistogram::Counts resultLatency{};           /**< 采集到显示结果的延迟分布 */
+        std::array<std::uint64_t, kStageCount> stageNs{};   /**< 各阶段累计耗时 */
+        std::array<std::uint64_t, kStageCount> stageRuns{}; /**< 各阶段执行次数 */
+    };
+
+    /**
+     * @brief 两次快照之间的统计
+     */
+    struct Report {
+        double seconds = 0;                          /**< 统计时长 */
+        double captureFps = 0;                       /**< 采集帧率 */
+        double decodeFps = 0;                        /**< 识别帧率 */
+        double decodeP50Ms = 0;                      /**< 识别耗时中位数 */
+        double decodeP95Ms = 0;                      /**< 识别耗时 95 分位 */
+        double resultP50Ms = 0;                      /**< 采集到显示结果的延迟中位数 */
+        double resultP95Ms = 0;                      /**< 采集到显示结果的延迟 95 分位 */
+        std::array<double, kStageCount> stageMs{};   /**< 各阶段每次执行的平均耗时 */
+        std::array<double, kStageCount> stageLoad{}; /**< 各阶段占用的核心数（耗时 / 统计时长） */
+
+        /**
+         * @brief 生成可读的多行文本
+         */
+        QString toText() const;
+    };
+
+    /**
+     * @brief 采集到一帧（采集线程）
+     */
+    void frameCaptured();
+
+    /**
+     * @brief 一帧识别完成（识别线程）
+     * @param elapsed 识别耗时
+     */
+    void frameDecoded(clock::duration elapsed);
+
+    /**
+     * @brief 识别结果已显示（界面线程）
+     * @param latency 从采集到显示的延迟
+     */
+    void resultShown(clock::duration latency);
+
+    /**
+     * @brief 记录一个阶段的耗时
+     */
+    void addStageTime(PipelineStage stage, clock::duration elapsed);
+
+    /**
+     * @brief 当前累计值
+     */
+    Snapshot snapshot() const;
+
+    /**
+     * @brief 计算两次快照之间的统计
+     */
+    static Report compare(const Snapshot &previous, const Snapshot &current);
+
+    /**
+     * @brief 阶段的显示名称
+     */
+    static QString stageName(PipelineStage stage);
+
+private:
+    std::atomic<std::uint64_t> captured{0};                          /**< 采集的帧数 */
+    std::atomic<std::uint64_t> decoded{0};                           /**< 识别完成的帧数 */
+    LatencyHistogram decodeLatency;                                  /**< 识别耗时分布 */
+    LatencyHistogram resultLatency;                                  /**< 采集到显示结果的延迟分布 */
+    std::array<std::atomic<std::uint64_t>, kStageCount> stageNs{};   /**< 各阶段累计耗时（纳秒） */
+    std::array<std::atomic<std::uint64_t>, kStageCount> stageRuns{}; /**< 各阶段执行次数 */
+};
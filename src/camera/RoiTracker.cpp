@@ -0,0 +1,57 @@
+#include "RoiTracker.h"
+#include <algorithm>
+#include <opencv2/imgproc.hpp>
+
+namespace {
+
+/**
+ * @brief ROI 至少扩展的像素数，避免小条码的静区被裁掉
+ */
+constexpr int kMinPaddingPx = 16;
+
+} // namespace
+
+RoiTracker::RoiTracker(int fullScanInterval, double padding)
+    : fullScanInterval(std::max(fullScanInterval, 1)), padding(std::max(padding, 0.0)) {}
+
+RoiTracker::Plan RoiTracker::plan(const cv::Size &frameSize) {
+    std::lock_guard lock(mutex);
+    Plan plan;
+    if (tracks.empty() || ++framesSinceFullScan >= fullScanInterval) {
+        framesSinceFullScan = 0;
+        return plan;
+    }
+
+    const cv::Rect frameRect({0, 0}, frameSize);
+    for (const auto &quad : tracks) {
+        const cv::Rect box = cv::boundingRect(quad);
+        const int pad = std::max(kMinPaddingPx, static_cast<int>(std::max(box.width, box.height) * padding));
+        const cv::Rect roi = cv::Rect(box.x - pad, box.y - pad, box.width + 2 * pad, box.height + 2 * pad) & frameRect;
+        if (roi.area() > 0) {
+            plan.rois.push_back(roi);
+        }
+    }
+    plan.fullScan = plan.rois.empty();
+    return plan;
+}
+
+bool RoiTracker::update(clock::time_point timestamp, bool fullScan, const std::vector<std::vector<cv::Point>> &quads) {
+    std::lock_guard lock(mutex);
+    // 较慢的工作线程可能在更新的帧之后才完成，它的结果已经过时
+    if (timestamp < lastUpdate) {
+        return false;
+    }
+    lastUpdate = timestamp;
+    if (fullScan) {
+        framesSinceFullScan = 0;
+    }
+    tracks = quads;
+    return true;
+}
+
+void RoiTracker::reset() {
+    std::lock_guard lock(mutex);
+    tracks.clear();
+    framesSinceFullScan = 0;
+    lastUpdate = {};
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <opencv2/core.hpp>
+#include <vector>
+
+/**
+ * @class RoiTracker
+ * @brief 连续扫描的 ROI 跟踪：记住条码上次出现的位置，后续帧优先只识别这些区域
+ *
+ * 摄像头前的条码通常在连续多帧中停留在同一位置。跟踪器保存每个条码的四边形位置，
+ * 后续帧只在扩展后的外接矩形内识别，开销与 ROI 面积成正比而不是与整帧成正比。
+ * 每隔 fullScanInterval 帧、没有跟踪目标或某个 ROI 未识别到条码时，退回全帧识别以发现新条码。
+ * 识别池的多个工作线程共享同一个跟踪器，内部状态很小，用互斥锁保护。
+ * 工作线程完成的顺序不固定，更新按采集时间排序，比已应用的结果更早的帧不会覆盖较新的跟踪目标。
+ */
+class RoiTracker {
+public:
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * @brief 一帧的识别计划
+     */
+    struct Plan {
+        bool fullScan = true;       /**< 是否全帧识别 */
+        std::vector<cv::Rect> rois; /**< 非全帧识别时需要识别的区域（帧像素坐标） */
+    };
+
+    /**
+     * @param fullScanInterval 每隔多少帧强制全帧识别
+     * @param padding ROI 向四周扩展的比例（相对条码外接矩形的长边）
+     */
+    RoiTracker(int fullScanInterval, double padding);
+
+    /**
+     * @brief 为下一帧生成识别计划
+     * @param frameSize 帧尺寸
+     */
+    Plan plan(const cv::Size &frameSize);
+
+    /**
+     * @brief 用识别结果更新跟踪目标
+     * @param timestamp 本帧的采集时间；早于上次更新的帧的结果被丢弃
+     * @param fullScan 本帧是否做了全帧识别；全帧识别的结果会替换全部跟踪目标
+     * @param quads 本帧识别到的条码四边形（帧像素坐标）
+     * @return 是否已应用
+     */
+    bool update(clock::time_point timestamp, bool fullScan, const std::vector<std::vector<cv::Point>> &quads);
+
+    /**
+     * @brief 清空跟踪目标（切换摄像头等画面不连续时调用）
+     */
+    void reset();
+
+private:
+    const int fullScanInterval;                 /**< 全帧识别间隔 */
+    const double padding;                       /**< ROI 扩展比例 */
+    std::mutex mutex;                           /**< 保护以下状态 */
+    std::vector<std::vector<cv::Point>> tracks; /**< 当前跟踪的条码四边形 */
+    int framesSinceFullScan = 0;                /**< 距上次全帧识别的帧数 */
+    clock::time_point lastUpdate;               /**< 已应用的最新结果的采集时间 */
+};
@@ -0,0 +1,147 @@
+#include "ScanConfig.h"
+#include <algorithm>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+using json = nlohmann::json;
+
+ScanConfig ScanConfig::load(const std::string &filename) {
+    ScanConfig config;
+
+    std::ifstream file(filename);
+    json config_json;
+    if (file.is_open()) {
+        try {
+            file >> config_json;
+        } catch (const json::exception &e) {
+            spdlog::warn("配置文件解析失败: {}", e.what());
+        }
+    }
+
+    if (config_json.contains("camera") && config_json["camera"].is_object()) {
+        const auto &camera = config_json["camera"];
+        if (camera.contains("roi_tracking") && camera["roi_tracking"].is_boolean()) {
+            config.roiTracking = camera["roi_tracking"].get<bool>();
+        }
+        if (camera.contains("full_scan_interval") && camera["full_scan_interval"].is_number_integer()) {
+            config.fullScanInterval = std::max(camera["full_scan_interval"].get<int>(), 1);
+        }
+        if (camera.contains("roi_padding") && camera["roi_padding"].is_number()) {
+            config.roiPadding = std::clamp(camera["roi_padding"].get<double>(), 0.0, 4.0);
+        }
+        if (camera.contains("coarse_scales") && camera["coarse_scales"].is_array()) {
+            config.coarseScales.clear();
+            for (const auto &scale : camera["coarse_scales"]) {
+                if (scale.is_number_integer() && scale.get<int>() >= 1) {
+                    config.coarseScales.push_back(scale.get<int>());
+                }
+            }
+        }
+        if (camera.contains("luma_only") && camera["luma_only"].is_boolean()) {
+            config.lumaOnly = camera["luma_only"].get<bool>();
+        }
+        if (camera.contains("track_ttl_ms") && camera["track_ttl_ms"].is_number_integer()) {
+            config.trackTtlMs = std::max(camera["track_ttl_ms"].get<int>(), 0);
+        }
+        if (camera.contains("try_harder") && camera["try_harder"].is_boolean()) {
+            config.tryHarder = camera["try_harder"].get<bool>();
+        }
+        if (camera.contains("try_rotate") && camera["try_rotate"].is_boolean()) {
+            config.tryRotate = camera["try_rotate"].get<bool>();
+        }
+        if (camera.contains("try_downscale") && camera["try_downscale"].is_boolean()) {
+            config.tryDownscale = camera["try_downscale"].get<bool>();
+        }
+        if (camera.contains("recording_directory") && camera["recording_directory"].is_string()) {
+            config.recordingDirectory = camera["recording_directory"].get<std::string>();
+        }
+        if (camera.contains("image_sequence_fps") && camera["image_sequence_fps"].is_number()) {
+            config.imageSequenceFps = std::clamp(camera["image_sequence_fps"].get<double>(), 0.1, 240.0);
+        }
+        if (camera.contains("loop_playback") && camera["loop_playback"].is_boolean()) {
+            config.loopPlayback = camera["loop_playback"].get<bool>();
+        }
+        if (camera.contains("gate") && camera["gate"].is_object()) {
+            const auto &gate = camera["gate"];
+            auto &out = config.gate;
+            if (gate.contains("enabled") && gate["enabled"].is_boolean()) {
+                out.enabled = gate["enabled"].get<bool>();
+            }
+            if (gate.contains("analysis_width") && gate["analysis_width"].is_number_integer()) {
+                out.analysisWidth = std::clamp(gate["analysis_width"].get<int>(), 16, 1920);
+            }
+            if (gate.contains("min_sharpness") && gate["min_sharpness"].is_number()) {
+                out.minSharpness = std::max(gate["min_sharpness"].get<double>(), 0.0);
+            }
+            if (gate.contains("min_difference") && gate["min_difference"].is_number()) {
+                out.minDifference = std::max(gate["min_difference"].get<double>(), 0.0);
+            }
+            if (gate.contains("max_skip_ms") && gate["max_skip_ms"].is_number_integer()) {
+                out.maxSkipMs = std::max(gate["max_skip_ms"].get<int>(), 0);
+            }
+        }
+        if (camera.contains("debug_frames") && camera["debug_frames"].is_object()) {
+            const auto &debug = camera["debug_frames"];
+            auto &out = config.debugFrames;
+            if (debug.contains("enabled") && debug["enabled"].is_boolean()) {
+                out.enabled = debug["enabled"].get<bool>();
+            }
+            if (debug.contains("directory") && debug["directory"].is_string()) {
+                out.directory = debug["directory"].get<std::string>();
+            }
+            if (debug.contains("format") && debug["format"].is_string()) {
+                const auto format = debug["format"].get<std::string>();
+                out.format = (format == "jpg" || format == "jpeg") ? "jpg" : "png";
+            }
+            if (debug.contains("jpeg_quality") && debug["jpeg_quality"].is_number_integer()) {
+                out.jpegQuality = std::clamp(debug["jpeg_quality"].get<int>(), 0, 100);
+            }
+            if (debug.contains("png_compression") && debug["png_compression"].is_number_integer()) {
+                out.pngCompression = std::clamp(debug["png_compression"].get<int>(), 0, 9);
+            }
+            if (debug.contains("max_per_second") && debug["max_per_second"].is_number()) {
+                out.maxPerSecond = std::max(debug["max_per_second"].get<double>(), 0.0);
+            }
+            if (debug.contains("queue_size") && debug["queue_size"].is_number_integer()) {
+                out.queueSize = std::max(debug["queue_size"].get<int>(), 1);
+            }
+            if (debug.contains("max_files") && debug["max_files"].is_number_integer()) {
+                out.maxFiles = std::max(debug["max_files"].get<int>(), 1);
+            }
+            if (debug.contains("max_mb") && debug["max_mb"].is_number_integer()) {
+                out.maxMegabytes = std::max(debug["max_mb"].get<int>(), 1);
+            }
+        }
+    }
+
+    spdlog::info("摄像头扫描配置: ROI 跟踪={}, 全帧间隔={}, ROI 扩展={}, 缩小倍数={}, 亮度模式={}, 条码保留={}ms",
+                 config.roiTracking,
+                 config.fullScanInterval,
+                 config.roiPadding,
+                 json(config.coarseScales).dump(),
+                 config.lumaOnly,
+                 config.trackTtlMs);
+    spdlog::info("识别选项: tryHarder={}, tryRotate={}, tryDownscale={}",
+                 config.tryHarder,
+                 config.tryRotate,
+                 config.tryDownscale);
+    spdlog::info("帧来源: 录制目录={}, 图片目录帧率={}, 循环播放={}",
+                 config.recordingDirectory,
+                 config.imageSequenceFps,
+                 config.loopPlayback);
+    spdlog::info("帧跳过: 启用={}, 分析宽度={}, 清晰度门限={}, 帧差门限={}, 最长跳过={}ms",
+                 config.gate.enabled,
+                 config.gate.analysisWidth,
+                 config.gate.minSharpness,
+                 config.gate.minDifference,
+                 config.gate.maxSkipMs);
+    spdlog::info("调试帧保存: 启用={}, 目录={}, 格式={}, 每秒最多={}, 最多保留 {} 个文件 / {} MB",
+                 config.debugFrames.enabled,
+                 config.debugFrames.directory,
+                 config.debugFrames.format,
+                 config.debugFrames.maxPerSecond,
+                 config.debugFrames.maxFiles,
+                 config.debugFrames.maxMegabytes);
+    return config;
+}
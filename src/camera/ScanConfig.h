@@ -0,0 +1,59 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/**
+ * @struct DebugFrameConfig
+ * @brief 调试帧保存参数，对应配置文件中 "camera" 节下的 "debug_frames"
+ */
+struct DebugFrameConfig {
+    bool enabled = true;                    /**< 是否在识别到新条码时保存整帧 */
+    std::string directory = "debug_frames"; /**< 保存目录 */
+    std::string format = "png";             /**< 图片格式：png 或 jpg */
+    int jpegQuality = 90;                   /**< JPEG 质量（0-100） */
+    int pngCompression = 3;                 /**< PNG 压缩级别（0-9） */
+    double maxPerSecond = 2.0;              /**< 每秒最多保存的帧数，超出的直接丢弃 */
+    int queueSize = 4;                      /**< 等待写盘的最大帧数，队列满时丢弃新帧 */
+    int maxFiles = 500;                     /**< 目录中最多保留的文件数，超出时删除最旧的 */
+    int maxMegabytes = 512;                 /**< 目录中文件的总大小上限（MB），超出时删除最旧的 */
+};
+
+/**
+ * @struct FrameGateConfig
+ * @brief 模糊与静止帧跳过参数，对应配置文件中 "camera" 节下的 "gate"
+ */
+struct FrameGateConfig {
+    bool enabled = true;        /**< 是否跳过模糊或静止的帧 */
+    int analysisWidth = 160;    /**< 计算指标时把帧缩小到的宽度（像素） */
+    double minSharpness = 20.0; /**< 清晰度（拉普拉斯方差）低于该值视为模糊 */
+    double minDifference = 2.0; /**< 与上次识别的帧的平均灰度差低于该值视为静止 */
+    int maxSkipMs = 1000;       /**< 连续跳过的最长时间（毫秒），应小于 track_ttl_ms */
+};
+
+/**
+ * @struct ScanConfig
+ * @brief 摄像头连续扫描参数，对应配置文件中的 "camera" 节
+ */
+struct ScanConfig {
+    bool roiTracking = true;                       /**< 是否启用 ROI 跟踪：在上次识别到条码的位置附近优先识别 */
+    int fullScanInterval = 10;                     /**< 启用 ROI 跟踪时，每隔多少帧强制做一次全帧识别 */
+    double roiPadding = 0.5;                       /**< ROI 在条码外接矩形基础上向四周扩展的比例 */
+    std::vector<int> coarseScales{4, 2, 1};        /**< 全帧识别时依次尝试的缩小倍数，1 表示原分辨率 */
+    bool lumaOnly = false;                         /**< 亮度模式：识别只使用采集时提取一次的亮度平面，彩色只用于预览 */
+    int trackTtlMs = 3000;                         /**< 条码离开画面多久后再出现视为新条码（毫秒） */
+    bool tryHarder = true;                         /**< ZXing tryHarder：更彻底地搜索，更慢 */
+    bool tryRotate = true;                         /**< ZXing tryRotate：同时尝试旋转 90° 的图像 */
+    bool tryDownscale = true;                      /**< ZXing tryDownscale：大图同时尝试缩小后识别 */
+    std::string recordingDirectory = "recordings"; /**< 会话录制的保存目录 */
+    double imageSequenceFps = 10.0;                /**< 播放图片目录时的帧率 */
+    bool loopPlayback = true;                      /**< 视频文件、图片目录和录制的会话播放完后是否从头循环 */
+    FrameGateConfig gate;                          /**< 模糊与静止帧跳过参数 */
+    DebugFrameConfig debugFrames;                  /**< 调试帧保存参数 */
+
+    /**
+     * @brief 从配置文件读取，缺失的字段使用默认值
+     * @param filename 配置文件路径
+     */
+    static ScanConfig load(const std::string &filename);
+};
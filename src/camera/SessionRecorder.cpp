@@ -0,0 +1,104 @@
+#include "SessionRecorder.h"
+#include "FrameSource.h"
+#include "sysinfo.h"
+#include <iomanip>
+#include <opencv2/imgproc.hpp>
+#include <spdlog/spdlog.h>
+
+SessionRecorder::SessionRecorder(const std::filesystem::path &directory, double fps)
+    : videoPath(directory / ("session_" + sysinfo::getCurrentTimeString("%Y-%m-%d_%H-%M-%S") + ".mkv")),
+      fps(fps > 0 ? fps : 30.0) {
+    thread = std::thread(&SessionRecorder::run, this);
+}
+
+SessionRecorder::~SessionRecorder() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    ready.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+    if (written > 0) {
+        spdlog::info("会话录制结束: {}，共 {} 帧，丢弃 {} 帧", videoPath.string(), written, dropped);
+    }
+}
+
+bool SessionRecorder::submit(const cv::Mat &frame, clock::time_point timestamp) {
+    if (frame.empty()) {
+        return false;
+    }
+    {
+        std::lock_guard lock(mutex);
+        if (stopping || queue.size() >= kQueueSize) {
+            ++dropped;
+            return false;
+        }
+        queue.push_back({frame, timestamp});
+    }
+    ready.notify_one();
+    return true;
+}
+
+std::uint64_t SessionRecorder::droppedCount() const {
+    std::lock_guard lock(mutex);
+    return dropped;
+}
+
+const std::filesystem::path &SessionRecorder::path() const {
+    return videoPath;
+}
+
+void SessionRecorder::run() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock lock(mutex);
+            ready.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) {
+                return; // 正在停止且队列已写完
+            }
+            job = std::move(queue.front());
+            queue.pop_front();
+        }
+        write(job);
+    }
+}
+
+void SessionRecorder::write(const Job &job) {
+    const cv::Mat *frame = &job.frame;
+    if (job.frame.channels() == 4) {
+        cv::cvtColor(job.frame, converted, cv::COLOR_BGRA2BGR);
+        frame = &converted;
+    }
+
+    if (!writer.isOpened()) {
+        if (failed) {
+            return;
+        }
+        std::error_code ec;
+        std::filesystem::create_directories(videoPath.parent_path(), ec);
+        const int fourcc = cv::VideoWriter::fourcc('M', 'J', 'P', 'G');
+        if (!writer.open(videoPath.string(), fourcc, fps, frame->size(), frame->channels() != 1)) {
+            spdlog::warn("无法创建录制文件: {}", videoPath.string());
+            failed = true;
+            return;
+        }
+        timestamps.open(RecordedSessionSource::timestampPath(videoPath));
+        // 默认的 6 位有效数字在录制约 1000 秒后只能精确到 10ms，回放节奏会走样，固定保留到微秒
+        timestamps << "frame,ms\n" << std::fixed << std::setprecision(3);
+        frameSize = frame->size();
+        first = job.timestamp;
+        spdlog::info("开始录制会话: {}", videoPath.string());
+    }
+
+    // 容器中的帧尺寸必须一致，录制中途分辨率改变后的帧不写入
+    if (frame->size() != frameSize) {
+        return;
+    }
+    writer.write(*frame);
+    const std::chrono::duration<double, std::milli> offset = job.timestamp - first;
+    timestamps << written << ',' << offset.count() << '\n';
+    ++written;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <opencv2/core.hpp>
+#include <opencv2/videoio.hpp>
+#include <thread>
+
+/**
+ * @class SessionRecorder
+ * @brief 在后台线程中把采集到的帧录制为 MJPEG 编码的 MKV 文件，并记录每帧的采集时间
+ *
+ * 录制结果由 RecordedSessionSource 按原时间戳回放，可以在没有摄像头的机器上重现现场的画面和帧间隔。
+ * 每帧的时间戳（相对第一帧的毫秒数）写入同名的 .csv 文件。submit() 只把帧的租约放入有界队列，
+ * 编码和写盘都在后台线程中完成；队列满时丢弃新帧，时间戳文件中不会出现被丢弃的帧。
+ */
+class SessionRecorder {
+public:
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * @brief 等待写盘的最大帧数，采集缓冲区池需要为此预留同样多的缓冲区
+     */
+    static constexpr std::size_t kQueueSize = 4;
+
+    /**
+     * @brief 创建并启动写盘线程，文件在收到第一帧时创建
+     * @param directory 保存目录
+     * @param fps 写入容器的标称帧率，回放以时间戳为准
+     */
+    SessionRecorder(const std::filesystem::path &directory, double fps);
+
+    /**
+     * @brief 写完队列中剩余的帧后关闭文件
+     */
+    ~SessionRecorder();
+
+    SessionRecorder(const SessionRecorder &) = delete;
+    SessionRecorder &operator=(const SessionRecorder &) = delete;
+
+    /**
+     * @brief 提交一帧，不阻塞
+     * @param frame 视频帧，只读共享
+     * @param timestamp 采集时间
+     * @return 是否被接受；队列已满时返回 false
+     */
+    bool submit(const cv::Mat &frame, clock::time_point timestamp);
+
+    /**
+     * @brief 因队列已满被丢弃的帧数
+     */
+    std::uint64_t droppedCount() const;
+
+    /**
+     * @brief 视频文件路径
+     */
+    const std::filesystem::path &path() const;
+
+private:
+    /**
+     * @brief 等待写盘的帧
+     */
+    struct Job {
+        cv::Mat frame;               /**< 视频帧 */
+        clock::time_point timestamp; /**< 采集时间 */
+    };
+
+    /**
+     * @brief 写盘线程主循环
+     */
+    void run();
+
+    /**
+     * @brief 编码并写入一帧，第一帧时打开文件
+     */
+    void write(const Job &job);
+
+    const std::filesystem::path videoPath; /**< 视频文件路径 */
+    const double fps;                      /**< 标称帧率 */
+    std::thread thread;                    /**< 写盘线程 */
+
+    mutable std::mutex mutex;      /**< 保护 queue、stopping 与 dropped */
+    std::condition_variable ready; /**< 有新帧或停止时通知 */
+    std::deque<Job> queue;         /**< 等待写盘的帧 */
+    bool stopping = false;         /**< 是否正在停止 */
+    std::uint64_t dropped = 0;     /**< 被丢弃的帧数 */
+
+    cv::VideoWriter writer;    /**< 视频编码器，只在写盘线程中使用 */
+    std::ofstream timestamps;  /**< 时间戳文件，只在写盘线程中使用 */
+    cv::Mat converted;         /**< BGRA 转 BGR 的缓冲区 */
+    cv::Size frameSize;        /**< 录制的帧尺寸 */
+    clock::time_point first;   /**< 第一帧的采集时间 */
+    std::uint64_t written = 0; /**< 已写入的帧数 */
+    bool failed = false;       /**< 文件创建失败，不再重试 */
+};
@@ -1,14 +1,38 @@
 #pragma once
+#include <QByteArray>
+#include <QPolygon>
 #include <QString>
+#include <chrono>
 #include <opencv2/core/mat.hpp>
+#include <vector>
+
+/**
+ * @brief 预览画面上叠加显示的条码轮廓（帧像素坐标）
+ */
+struct BarcodeOutline {
+    QPolygon polygon;
+    QString text;
+};
+
+/**
+ * @brief 一帧中识别到的一个条码
+ */
+struct ScannedCode {
+    int trackId = 0;        // 跟踪编号，同一个条码在连续帧中保持不变
+    bool isNew = false;     // 是否首次出现（每个跟踪编号只报告一次）
+    QString type;
+    QString content;
+    cv::Mat rectifiedImage; // 矫正后的条码图片，只在首次出现时生成
+    QByteArray png;         // rectifiedImage 的 PNG 编码，在识别线程中生成
+};
 
 /**
  * @brief 结构体表示一帧图像及其二维码扫描结果
  */
 struct FrameResult {
     cv::Mat frame;
-    cv::Mat rectifiedImage;
     bool hasBarcode = false;
-    QString type;
-    QString content;
+    std::vector<ScannedCode> codes; // 本帧识别到的全部条码
+    std::vector<BarcodeOutline> outlines;
+    std::chrono::steady_clock::time_point timestamp; // 采集时间
 };
\ No newline at end of file
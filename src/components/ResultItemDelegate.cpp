@@ -0,0 +1,106 @@
+#include "ResultItemDelegate.h"
+#include "ResultListModel.h"
+#include <QPainter>
+
+namespace {
+
+constexpr int kContentSize = ResultListModel::kThumbnailSize; // 内容区边长
+constexpr int kNameHeight = 20;                               // 文件名区域高度
+constexpr int kCellPadding = 10;                              // 单元格内边距
+constexpr int kSpacing = 5;                                   // 文件名与内容区间距
+
+QFont nameFont(const QFont &base) {
+    QFont font = base;
+    font.setPointSize(10);
+    font.setBold(true);
+    return font;
+}
+
+} // namespace
+
+ResultItemDelegate::ResultItemDelegate(QObject *parent)
+    : QStyledItemDelegate(parent) {}
+
+void ResultItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const {
+    painter->save();
+    painter->setRenderHint(QPainter::SmoothPixmapTransform);
+
+    const QRect cell = option.rect.adjusted(kCellPadding, kCellPadding, -kCellPadding, -kCellPadding);
+    const QRect nameRect(cell.x(), cell.y(), kContentSize, kNameHeight);
+    const QRect contentRect(cell.x(), nameRect.bottom() + 1 + kSpacing, kContentSize, kContentSize);
+
+    // 文件名，过长时中间省略
+    const QFont font = nameFont(option.font);
+    painter->setFont(font);
+    painter->setPen(QColor("#333"));
+    const QString name = index.data(Qt::DisplayRole).toString();
+    painter->drawText(nameRect, Qt::AlignCenter, QFontMetrics(font).elidedText(name, Qt::ElideMiddle, kContentSize));
+
+    const bool hovered = option.state & QStyle::State_MouseOver;
+    const auto kind = static_cast<ResultListModel::Kind>(index.data(ResultListModel::KindRole).toInt());
+
+    switch (kind) {
+    case ResultListModel::Image: {
+        painter->fillRect(contentRect, Qt::white);
+        const QPixmap pixmap = index.data(Qt::DecorationRole).value<QPixmap>();
+        if (pixmap.isNull()) {
+            // 缩略图仍在后台生成
+            painter->setPen(QColor("#aaa"));
+            painter->setFont(option.font);
+            painter->drawText(contentRect, Qt::AlignCenter, "加载中...");
+        } else {
+            const QSize size = pixmap.size().scaled(contentRect.size(), Qt::KeepAspectRatio);
+            QRect target(QPoint(0, 0), size);
+            target.moveCenter(contentRect.center());
+            painter->drawPixmap(target, pixmap);
+        }
+        painter->setPen(QColor(hovered ? "#40a9ff" : "#ddd"));
+        painter->drawRect(contentRect.adjusted(0, 0, -1, -1));
+        break;
+    }
+    case ResultListModel::Text: {
+        painter->fillRect(contentRect, Qt::white);
+        QFont textFont = option.font;
+        textFont.setFamily("Consolas");
+        painter->setFont(textFont);
+        painter->setPen(QColor("#333"));
+        painter->drawText(contentRect.adjusted(5, 5, -5, -5),
+                          Qt::AlignTop | Qt::AlignLeft | Qt::TextWrapAnywhere,
+                          index.data(ResultListModel::PreviewTextRole).toString());
+        painter->setPen(QColor(hovered ? "#40a9ff" : "#ddd"));
+        painter->drawRect(contentRect.adjusted(0, 0, -1, -1));
+        break;
+    }
+    case ResultListModel::Error: {
+        painter->fillRect(contentRect, QColor("#fff0f0"));
+        QFont errFont = option.font;
+        errFont.setPointSize(15);
+        painter->setFont(errFont);
+        painter->setPen(Qt::red);
+        painter->drawText(contentRect.adjusted(5, 5, -5, -5),
+                          Qt::AlignTop | Qt::AlignLeft | Qt::TextWordWrap,
+                          index.data(ResultListModel::PreviewTextRole).toString());
+        painter->drawRect(contentRect.adjusted(0, 0, -1, -1));
+        break;
+    }
+    case ResultListModel::Pending:
+    default: {
+        painter->fillRect(contentRect, QColor("#f9f9f9"));
+        painter->setPen(QPen(QColor("#ccc"), 1, Qt::DashLine));
+        painter->drawRect(contentRect.adjusted(0, 0, -1, -1));
+        painter->setPen(QColor("#aaa"));
+        painter->setFont(option.font);
+        painter->drawText(contentRect, Qt::AlignCenter, "处理中...");
+        break;
+    }
+    }
+
+    painter->restore();
+}
+
+QSize ResultItemDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const {
+    Q_UNUSED(option);
+    Q_UNUSED(index);
+    // 所有项尺寸一致，且不读取任何数据，避免布局时为全部结果请求缩略图
+    return {kContentSize + 2 * kCellPadding, kNameHeight + kSpacing + kContentSize + 2 * kCellPadding};
+}
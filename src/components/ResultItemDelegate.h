@@ -0,0 +1,20 @@
+#pragma once
+
+#include <QStyledItemDelegate>
+
+/**
+ * @class ResultItemDelegate
+ * @brief 批处理结果网格的绘制代理
+ *
+ * 每一项只在可见时绘制：上方为文件名，下方为 200x200 的内容区（缩略图 / 文本预览 / 错误信息）。
+ * 不为每个结果创建控件，十万级结果也能流畅滚动。
+ */
+class ResultItemDelegate : public QStyledItemDelegate {
+    Q_OBJECT
+public:
+    explicit ResultItemDelegate(QObject *parent = nullptr);
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+};
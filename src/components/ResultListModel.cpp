@@ -0,0 +1,153 @@
+#include "ResultListModel.h"
+#include "ThumbnailService.h"
+#include <QFileInfo>
+#include <algorithm>
+
+namespace {
+
+constexpr int kPreviewChars = 256; // 文本预览最多显示的字符数
+
+ResultListModel::Kind kindOf(const convert::result_data_entry &entry) {
+    if (std::holds_alternative<QImage>(entry.data)) {
+        return ResultListModel::Image;
+    }
+    if (std::holds_alternative<QByteArray>(entry.data)) {
+        return ResultListModel::Text;
+    }
+    if (std::holds_alternative<std::string>(entry.data)) {
+        return ResultListModel::Error;
+    }
+    return ResultListModel::Pending;
+}
+
+} // namespace
+
+ResultListModel::ResultListModel(const std::vector<convert::result_data_entry> &results, QObject *parent)
+    : QAbstractListModel(parent), results(results) {}
+
+int ResultListModel::rowCount(const QModelIndex &parent) const {
+    if (parent.isValid()) {
+        return 0;
+    }
+    return static_cast<int>(results.size());
+}
+
+QVariant ResultListModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= rowCount()) {
+        return {};
+    }
+
+    const int row = index.row();
+    const auto &entry = results[row];
+
+    switch (role) {
+    case Qt::DisplayRole: {
+        const QString fileName = QFileInfo(entry.source_file_name).fileName();
+        return fileName.isEmpty() ? QStringLiteral("Unknown") : fileName;
+    }
+    case Qt::ToolTipRole:
+        if (const auto *img = std::get_if<QImage>(&entry.data)) {
+            return QString("%1\nSize: %2x%3").arg(entry.source_file_name).arg(img->width()).arg(img->height());
+        }
+        return entry.source_file_name;
+    case KindRole: return kindOf(entry);
+    case PreviewTextRole:
+        if (const auto *bytes = std::get_if<QByteArray>(&entry.data)) {
+            // 只转换开头一段，避免大文件在每次绘制时整体解码
+            QString text = QString::fromUtf8(bytes->left(kPreviewChars * 4));
+            if (text.length() > kPreviewChars || bytes->size() > kPreviewChars * 4) {
+                text = text.left(kPreviewChars) + "...";
+            }
+            return text;
+        }
+        if (const auto *err = std::get_if<std::string>(&entry.data)) {
+            return QString::fromStdString(*err);
+        }
+        return {};
+    case Qt::DecorationRole:
+        if (!std::holds_alternative<QImage>(entry.data)) {
+            return {};
+        }
+        return thumbnail(row);
+    default: return {};
+    }
+}
+
+void ResultListModel::reset() {
+    beginResetModel();
+    ++generation;
+    cancelThumbnails();
+    endResetModel();
+}
+
+void ResultListModel::beginResultsChange() {
+    beginResetModel();
+    ++generation;
+    cancelThumbnails();
+}
+
+void ResultListModel::endResultsChange() {
+    endResetModel();
+}
+
+void ResultListModel::updateRows(const std::vector<int> &rows) {
+    for (const int row : rows) {
+        if (row < 0 || row >= rowCount()) {
+            continue;
+        }
+        const QModelIndex idx = index(row);
+        emit dataChanged(idx, idx);
+    }
+}
+
+void ResultListModel::setVisibleRows(int first, int last) {
+    auto &service = ThumbnailService::instance();
+    for (auto it = pendingThumbnails.begin(); it != pendingThumbnails.end();) {
+        QVector<int> &rows = it.value();
+        rows.erase(std::remove_if(rows.begin(), rows.end(), [&](int row) { return row < first || row > last; }),
+                   rows.end());
+        if (rows.isEmpty()) {
+            service.cancel(it.key(), QSize(kThumbnailSize, kThumbnailSize), this);
+            it = pendingThumbnails.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void ResultListModel::cancelThumbnails() {
+    auto &service = ThumbnailService::instance();
+    for (auto it = pendingThumbnails.cbegin(); it != pendingThumbnails.cend(); ++it) {
+        service.cancel(it.key(), QSize(kThumbnailSize, kThumbnailSize), this);
+    }
+    pendingThumbnails.clear();
+}
+
+QPixmap ResultListModel::thumbnail(int row) const {
+    const auto &image = std::get<QImage>(results[row].data);
+    const QString key = ThumbnailService::keyFor(image);
+    const quint64 requestGeneration = generation;
+    auto *self = const_cast<ResultListModel *>(this);
+
+    // 内容相同的结果共享同一张图片，同一个 key 可能有多个项在等待；服务对同一模型只回调一次
+    const QPixmap pixmap = ThumbnailService::instance().thumbnail(
+        key, QSize(kThumbnailSize, kThumbnailSize), image, self, [self, key, requestGeneration](const QPixmap &pixmap) {
+            const QVector<int> rows = self->pendingThumbnails.take(key);
+            // 生成失败时没有新的内容可显示，不刷新，避免再次请求
+            if (pixmap.isNull() || requestGeneration != self->generation) {
+                return;
+            }
+            for (const int row : rows) {
+                if (row < self->rowCount()) {
+                    const QModelIndex idx = self->index(row);
+                    emit self->dataChanged(idx, idx, {Qt::DecorationRole});
+                }
+            }
+        });
+    if (pixmap.isNull()) {
+        if (QVector<int> &rows = pendingThumbnails[key]; !rows.contains(row)) {
+            rows.append(row);
+        }
+    }
+    return pixmap;
+}
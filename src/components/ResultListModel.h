@@ -0,0 +1,98 @@
+#pragma once
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QPixmap>
+#include <QVector>
+#include <vector>
+
+#include "../convert.h"
+
+/**
+ * @class ResultListModel
+ * @brief 批处理结果列表模型
+ *
+ * 直接引用 BarcodeWidget 中的结果数组，不复制数据。
+ * 图片结果的缩略图只在视图请求时（即该项可见时）才交给 ThumbnailService 在后台生成，
+ * 因此结果数量再多，界面线程也只为可见的几十项付出绘制代价。
+ * 视图滚动后通过 setVisibleRows() 告知可见范围，已滚出可见区域的项撤销尚未开始的缩略图任务。
+ */
+class ResultListModel : public QAbstractListModel {
+    Q_OBJECT
+public:
+    /**
+     * @brief 自定义数据角色
+     */
+    enum Role {
+        KindRole = Qt::UserRole + 1, /**< 结果类型，取值见 Kind */
+        PreviewTextRole,             /**< 文本 / 错误结果的预览文字 */
+    };
+
+    /**
+     * @brief 结果类型
+     */
+    enum Kind {
+        Pending, /**< 尚未完成 */
+        Image,   /**< 生成的条码图片 */
+        Text,    /**< 解码得到的内容 */
+        Error,   /**< 错误信息 */
+    };
+
+    static constexpr int kThumbnailSize = 200; /**< 缩略图边长 */
+
+    /**
+     * @brief 构造函数
+     * @param results 结果数组，生命周期需长于模型
+     * @param parent 父对象
+     */
+    explicit ResultListModel(const std::vector<convert::result_data_entry> &results, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    QVariant data(const QModelIndex &index, int role) const override;
+
+    /**
+     * @brief 结果数组整体变化后调用，重置视图
+     */
+    void reset();
+
+    /**
+     * @brief 结果数组即将被清空或重新赋值时调用，之后必须调用 endResultsChange()
+     */
+    void beginResultsChange();
+
+    /**
+     * @brief 结果数组修改完成
+     */
+    void endResultsChange();
+
+    /**
+     * @brief 部分结果完成后调用，通知视图刷新对应的项
+     * @param rows 发生变化的结果索引
+     */
+    void updateRows(const std::vector<int> &rows);
+
+    /**
+     * @brief 视图的可见范围变化后调用，撤销范围外的项尚未完成的缩略图请求
+     * @param first 第一个可见项
+     * @param last 最后一个可见项
+     */
+    void setVisibleRows(int first, int last);
+
+private:
+    /**
+     * @brief 获取缩略图，未生成时提交给 ThumbnailService，完成后刷新对应的项
+     * @param row 结果索引
+     * @return 缩略图，尚未生成时为空
+     */
+    QPixmap thumbnail(int row) const;
+
+    /**
+     * @brief 撤销所有尚未完成的缩略图请求
+     */
+    void cancelThumbnails();
+
+    const std::vector<convert::result_data_entry> &results; /**< 结果数组 */
+    quint64 generation = 0;                                 /**< 每次 reset 递增，用于忽略过期的缩略图回调 */
+    mutable QHash<QString, QVector<int>> pendingThumbnails; /**< 正在生成的缩略图及等待它的项，key 为来源标识 */
+};
@@ -0,0 +1,100 @@
+#include "ScanResultModel.h"
+#include "ThumbnailService.h"
+#include <QColor>
+
+ScanResultModel::ScanResultModel(QObject *parent)
+    : QAbstractTableModel(parent) {}
+
+int ScanResultModel::rowCount(const QModelIndex &parent) const {
+    if (parent.isValid()) {
+        return 0;
+    }
+    return static_cast<int>(entries.size());
+}
+
+int ScanResultModel::columnCount(const QModelIndex &parent) const {
+    if (parent.isValid()) {
+        return 0;
+    }
+    return ColumnCount;
+}
+
+QVariant ScanResultModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= rowCount()) {
+        return {};
+    }
+
+    const auto &e = entries[index.row()];
+    switch (role) {
+    case Qt::DisplayRole:
+        switch (index.column()) {
+        case TimeColumn: return e.time;
+        case TypeColumn: return e.type;
+        case ContentColumn: return e.content;
+        default: return {};
+        }
+    case Qt::DecorationRole:
+        if (index.column() == ImageColumn && !e.thumbnail.isNull()) {
+            return e.thumbnail;
+        }
+        return {};
+    case Qt::ForegroundRole:
+        if (index.column() == TypeColumn) {
+            return QColor(Qt::blue); // 类型蓝色
+        }
+        return {};
+    case Qt::ToolTipRole:
+        if (index.column() == ContentColumn) {
+            return e.content;
+        }
+        return {};
+    default: return {};
+    }
+}
+
+QVariant ScanResultModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+    switch (section) {
+    case TimeColumn: return QStringLiteral("时间");
+    case ImageColumn: return QStringLiteral("图像");
+    case TypeColumn: return QStringLiteral("类型");
+    case ContentColumn: return QStringLiteral("内容");
+    default: return {};
+    }
+}
+
+void ScanResultModel::prepend(Entry entry, const cv::Mat &image) {
+    const int id = entry.id;
+    beginInsertRows(QModelIndex(), 0, 0);
+    entries.push_front(std::move(entry));
+    endInsertRows();
+
+    if (rowCount() > kMaxRows) {
+        beginRemoveRows(QModelIndex(), kMaxRows, rowCount() - 1);
+        entries.resize(kMaxRows);
+        endRemoveRows();
+    }
+
+    // 缩略图在后台生成，完成时该行可能已下移或被移除，所以按编号查找
+    const auto fill = [this, id](const QPixmap &pixmap) {
+        for (int row = 0; row < rowCount(); ++row) {
+            if (entries[row].id == id) {
+                entries[row].thumbnail = pixmap;
+                const QModelIndex idx = index(row, ImageColumn);
+                emit dataChanged(idx, idx, {Qt::DecorationRole});
+                return;
+            }
+        }
+    };
+    const QPixmap thumbnail = ThumbnailService::instance().thumbnail(
+        QStringLiteral("scan:%1").arg(id), QSize(kThumbnailSize, kThumbnailSize), image, this, fill);
+    if (!thumbnail.isNull()) {
+        fill(thumbnail);
+    }
+}
+
+const ScanResultModel::Entry &ScanResultModel::entry(int row) const {
+    return entries[row];
+}
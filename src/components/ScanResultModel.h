@@ -0,0 +1,71 @@
+#pragma once
+
+#include <QAbstractTableModel>
+#include <QByteArray>
+#include <QPixmap>
+#include <QSize>
+#include <deque>
+#include <opencv2/core.hpp>
+
+/**
+ * @class ScanResultModel
+ * @brief 摄像头扫描结果表格模型
+ *
+ * 矫正后的条码图片在识别线程中编码为 PNG，这里只保存二进制数据，界面线程不做编码；
+ * 导出 HTML 时才转为 Base64，导出 XLSX 时直接使用。缩略图由 ThumbnailService 在后台生成后回填。
+ */
+class ScanResultModel : public QAbstractTableModel {
+    Q_OBJECT
+public:
+    /**
+     * @brief 表格列
+     */
+    enum Column {
+        TimeColumn,    /**< 识别时间 */
+        ImageColumn,   /**< 缩略图 */
+        TypeColumn,    /**< 条码类型 */
+        ContentColumn, /**< 条码内容 */
+        ColumnCount,
+    };
+
+    /**
+     * @brief 一条扫描结果
+     */
+    struct Entry {
+        int id = 0;        /**< 条码跟踪编号，用于回填缩略图 */
+        QString time;      /**< 识别时间 */
+        QString type;      /**< 条码类型 */
+        QString content;   /**< 条码内容 */
+        QByteArray png;    /**< PNG 编码的矫正图片 */
+        QSize imageSize;   /**< 矫正图片尺寸 */
+        QPixmap thumbnail; /**< 缩略图，尚未生成时为空 */
+    };
+
+    static constexpr int kThumbnailSize = 128; /**< 缩略图边长 */
+    static constexpr int kMaxRows = 50;        /**< 最多保留的结果数 */
+
+    explicit ScanResultModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    QVariant data(const QModelIndex &index, int role) const override;
+
+    QVariant headerData(int section, Qt::Orientation orientation, int role) const override;
+
+    /**
+     * @brief 插入到顶部，超过 kMaxRows 时删除最旧的结果
+     * @param entry 扫描结果
+     * @param image 矫正后的图片（BGR 或灰度），用于在后台生成缩略图
+     */
+    void prepend(Entry entry, const cv::Mat &image);
+
+    /**
+     * @brief 第 row 行的扫描结果
+     */
+    const Entry &entry(int row) const;
+
+private:
+    std::deque<Entry> entries; /**< 扫描结果，最新的在前 */
+};
@@ -0,0 +1,223 @@
+#include "ThumbnailService.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QMetaObject>
+#include <QRunnable>
+#include <QThread>
+#include <algorithm>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+
+namespace {
+
+constexpr int kCacheKB = 96 * 1024; // 缩略图缓存上限 96MB
+
+/**
+ * @brief 包装可调用对象的 QRunnable（Qt 5.12 没有 QRunnable::create）
+ */
+class FunctionRunnable : public QRunnable {
+public:
+    explicit FunctionRunnable(std::function<void()> fn)
+        : fn(std::move(fn)) {}
+
+    void run() override {
+        fn();
+    }
+
+private:
+    std::function<void()> fn;
+};
+
+/**
+ * @brief 等比缩放到 box 以内：缩小用 INTER_AREA（区域平均），放大用双线性
+ */
+cv::Mat fitInto(const cv::Mat &src, const QSize &box) {
+    if (src.empty() || box.isEmpty()) {
+        return {};
+    }
+    const double scale = std::min(static_cast<double>(box.width()) / src.cols,
+                                  static_cast<double>(box.height()) / src.rows);
+    const cv::Size target(std::max(1, cvRound(src.cols * scale)), std::max(1, cvRound(src.rows * scale)));
+    if (target == src.size()) {
+        return src;
+    }
+    cv::Mat dst;
+    cv::resize(src, dst, target, 0, 0, scale < 1.0 ? cv::INTER_AREA : cv::INTER_LINEAR);
+    return dst;
+}
+
+/**
+ * @brief 将 BGR / 灰度 cv::Mat 深拷贝为 QImage
+ */
+QImage matToImage(const cv::Mat &mat) {
+    if (mat.type() == CV_8UC1) {
+        return QImage(mat.data, mat.cols, mat.rows, static_cast<int>(mat.step), QImage::Format_Grayscale8).copy();
+    }
+    cv::Mat rgb;
+    switch (mat.type()) {
+    case CV_8UC3: cv::cvtColor(mat, rgb, cv::COLOR_BGR2RGB); break;
+    case CV_8UC4: cv::cvtColor(mat, rgb, cv::COLOR_BGRA2RGB); break;
+    default: return {};
+    }
+    return QImage(rgb.data, rgb.cols, rgb.rows, static_cast<int>(rgb.step), QImage::Format_RGB888).copy();
+}
+
+} // namespace
+
+ThumbnailService &ThumbnailService::instance() {
+    // 由 QApplication 拥有，避免函数内静态对象在 QApplication 析构之后才释放 QPixmap
+    static auto *service = new ThumbnailService(QCoreApplication::instance());
+    return *service;
+}
+
+QString ThumbnailService::keyFor(const QImage &image) {
+    return QStringLiteral("image:%1").arg(image.cacheKey());
+}
+
+QString ThumbnailService::keyFor(const QString &filePath) {
+    const QFileInfo info(filePath);
+    return QStringLiteral("file:%1@%2").arg(info.absoluteFilePath()).arg(info.lastModified().toMSecsSinceEpoch());
+}
+
+ThumbnailService::ThumbnailService(QObject *parent)
+    : QObject(parent) {
+    cache.setMaxCost(kCacheKB);
+    pool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() / 2));
+    if (parent) {
+        connect(qobject_cast<QCoreApplication *>(parent), &QCoreApplication::aboutToQuit, this, [this] { shutdown(); });
+    }
+}
+
+ThumbnailService::~ThumbnailService() {
+    shutdown();
+}
+
+void ThumbnailService::shutdown() {
+    stopped = true;
+    pool.clear();
+    pool.waitForDone();
+    inflight.clear();
+    cache.clear();
+}
+
+QString ThumbnailService::cacheKeyFor(const QString &key, const QSize &size) {
+    return QStringLiteral("%1@%2x%3").arg(key).arg(size.width()).arg(size.height());
+}
+
+QPixmap ThumbnailService::thumbnail(
+    const QString &key, const QSize &size, const Source &source, QObject *context, Callback onReady) {
+    const QString cacheKey = cacheKeyFor(key, size);
+    if (const QPixmap *pixmap = cache.object(cacheKey)) {
+        return *pixmap;
+    }
+    if (stopped) {
+        return {};
+    }
+
+    // 同一来源同一尺寸已在生成中，只登记回调；视图每次重绘都会再次请求，同一 context 只登记一次
+    if (const auto it = inflight.find(cacheKey); it != inflight.end()) {
+        const auto sameContext = [context](const Waiter &w) { return w.context == context; };
+        if (std::none_of(it->waiters.cbegin(), it->waiters.cend(), sameContext)) {
+            it->waiters.append({context, std::move(onReady)});
+        }
+        return {};
+    }
+    Pending &pending = inflight[cacheKey];
+    pending.waiters.append({context, std::move(onReady)});
+    pending.cancelled = std::make_shared<std::atomic_bool>(false);
+    const auto cancelled = pending.cancelled;
+
+    auto *task = new FunctionRunnable([this, cacheKey, source, size, cancelled] {
+        // 排队期间已被撤销（如该项已滚出可见区域），不再生成
+        if (cancelled->load(std::memory_order_relaxed)) {
+            return;
+        }
+        const QImage image = render(source, size);
+        QMetaObject::invokeMethod(this, [this, cacheKey, image] { onRendered(cacheKey, image); }, Qt::QueuedConnection);
+    });
+    pool.start(task, ++requestPriority);
+    return {};
+}
+
+void ThumbnailService::cancel(const QString &key, const QSize &size, QObject *context) {
+    const auto it = inflight.find(cacheKeyFor(key, size));
+    if (it == inflight.end()) {
+        return;
+    }
+    auto &waiters = it->waiters;
+    waiters.erase(std::remove_if(waiters.begin(),
+                                 waiters.end(),
+                                 [context](const Waiter &w) { return !w.context || w.context == context; }),
+                  waiters.end());
+    if (waiters.isEmpty()) {
+        it->cancelled->store(true, std::memory_order_relaxed);
+        inflight.erase(it);
+    }
+}
+
+QImage ThumbnailService::render(const Source &source, const QSize &size) {
+    try {
+        if (const auto *image = std::get_if<QImage>(&source)) {
+            if (image->isNull()) {
+                return {};
+            }
+            if (image->format() == QImage::Format_Grayscale8) {
+                const cv::Mat gray(image->height(),
+                                   image->width(),
+                                   CV_8UC1,
+                                   const_cast<uchar *>(image->constBits()),
+                                   static_cast<size_t>(image->bytesPerLine()));
+                return matToImage(fitInto(gray, size));
+            }
+            // 其它格式统一转为 RGB888（仅在后台线程中发生拷贝）
+            const QImage rgb = image->convertToFormat(QImage::Format_RGB888);
+            const cv::Mat mat(rgb.height(),
+                              rgb.width(),
+                              CV_8UC3,
+                              const_cast<uchar *>(rgb.constBits()),
+                              static_cast<size_t>(rgb.bytesPerLine()));
+            const cv::Mat scaled = fitInto(mat, size);
+            return QImage(scaled.data, scaled.cols, scaled.rows, static_cast<int>(scaled.step), QImage::Format_RGB888)
+                .copy();
+        }
+        if (const auto *mat = std::get_if<cv::Mat>(&source)) {
+            return matToImage(fitInto(*mat, size));
+        }
+        if (const auto *path = std::get_if<QString>(&source)) {
+            const cv::Mat mat = cv::imread(path->toLocal8Bit().toStdString(), cv::IMREAD_COLOR);
+            return matToImage(fitInto(mat, size));
+        }
+    } catch (const cv::Exception &) {
+        // 无法解码的图片不生成缩略图
+    }
+    return {};
+}
+
+void ThumbnailService::onRendered(const QString &cacheKey, const QImage &image) {
+    if (stopped) {
+        return;
+    }
+    // 生成失败也放入缓存（空 QPixmap），否则每次重绘都会重新提交同一个注定失败的任务
+    QPixmap pixmap;
+    int costKB = 1;
+    if (!image.isNull()) {
+        pixmap = QPixmap::fromImage(image);
+        costKB = std::max(1, pixmap.width() * pixmap.height() * pixmap.depth() / 8 / 1024);
+    }
+    cache.insert(cacheKey, new QPixmap(pixmap), costKB);
+
+    // 生成开始后才被撤销的任务已不在 inflight 中，结果只放入缓存
+    const auto it = inflight.find(cacheKey);
+    if (it == inflight.end()) {
+        return;
+    }
+    const QVector<Waiter> waiters = std::move(it->waiters);
+    inflight.erase(it);
+
+    for (const auto &waiter : waiters) {
+        if (waiter.context && waiter.onReady) {
+            waiter.onReady(pixmap);
+        }
+    }
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <QCache>
+#include <QHash>
+#include <QImage>
+#include <QObject>
+#include <QPixmap>
+#include <QPointer>
+#include <QSize>
+#include <QThreadPool>
+#include <QVector>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <opencv2/core/mat.hpp>
+#include <variant>
+
+/**
+ * @class ThumbnailService
+ * @brief 全局共享的异步缩略图服务
+ *
+ * 批处理结果网格、摄像头扫描结果表格和已选文件列表共用同一个实例：
+ * - 缩放在后台线程池中用 OpenCV INTER_AREA（区域平均）完成，界面线程只负责 QImage -> QPixmap；
+ * - 结果放入按 (来源, 尺寸) 索引的有界 LRU 缓存；
+ * - 同一 (来源, 尺寸) 的并发请求合并为一次计算，完成后依次回调；同一 context 重复请求只登记一次回调；
+ * - 请求方不再需要时（如该项已滚出可见区域）调用 cancel()，尚未开始的任务直接跳过。
+ *
+ * 只能在界面线程中使用。实例的父对象是 QApplication，aboutToQuit 时停止后台任务并释放缓存，
+ * 保证 QPixmap 和线程池在 QApplication 析构之前销毁。
+ */
+class ThumbnailService : public QObject {
+    Q_OBJECT
+public:
+    /**
+     * @brief 缩略图来源：内存中的 QImage、BGR 格式的 cv::Mat 或图片文件路径
+     */
+    using Source = std::variant<QImage, cv::Mat, QString>;
+
+    /**
+     * @brief 缩略图生成完成后的回调，在界面线程中执行
+     */
+    using Callback = std::function<void(const QPixmap &)>;
+
+    /**
+     * @brief 获取全局实例，须在 QApplication 创建之后调用
+     */
+    static ThumbnailService &instance();
+
+    /**
+     * @brief 为内存中的 QImage 生成来源标识
+     */
+    static QString keyFor(const QImage &image);
+
+    /**
+     * @brief 为图片文件生成来源标识（包含修改时间，文件变化后自动失效）
+     */
+    static QString keyFor(const QString &filePath);
+
+    /**
+     * @brief 获取缩略图
+     *
+     * 命中缓存时直接返回；否则提交后台任务并返回空 QPixmap，生成完成后调用 onReady。
+     * 生成失败时以空 QPixmap 回调，失败结果同样缓存，之后的请求直接返回空 QPixmap 而不再重试。
+     * 同一 context 对同一 (key, size) 已有等待中的回调时不再登记 onReady，已登记的回调完成时只执行一次。
+     * context 被销毁后回调不会执行。
+     * @param key 来源标识，相同来源必须使用相同的 key
+     * @param size 缩略图最大尺寸（保持宽高比）
+     * @param source 缩略图来源
+     * @param context 回调的生命周期对象
+     * @param onReady 完成回调
+     * @return 缓存中的缩略图，未命中时为空
+     */
+    QPixmap thumbnail(const QString &key, const QSize &size, const Source &source, QObject *context, Callback onReady);
+
+    /**
+     * @brief 撤销 context 对某个缩略图的等待；没有其它等待者时，尚未开始的生成任务被跳过
+     * @param key 来源标识
+     * @param size 缩略图最大尺寸
+     * @param context 请求时传入的生命周期对象
+     */
+    void cancel(const QString &key, const QSize &size, QObject *context);
+
+private:
+    explicit ThumbnailService(QObject *parent = nullptr);
+
+    ~ThumbnailService() override;
+
+    /**
+     * @brief 后台线程中生成缩略图
+     */
+    static QImage render(const Source &source, const QSize &size);
+
+    /**
+     * @brief 后台任务完成（界面线程）
+     */
+    void onRendered(const QString &cacheKey, const QImage &image);
+
+    /**
+     * @brief 程序退出前停止后台任务并释放缓存
+     */
+    void shutdown();
+
+    /**
+     * @brief 缓存 key："来源@宽x高"
+     */
+    static QString cacheKeyFor(const QString &key, const QSize &size);
+
+    struct Waiter {
+        QPointer<QObject> context;
+        Callback onReady;
+    };
+
+    /**
+     * @brief 正在生成的任务
+     */
+    struct Pending {
+        QVector<Waiter> waiters;                     /**< 等待该任务的回调 */
+        std::shared_ptr<std::atomic_bool> cancelled; /**< 所有等待者都已撤销，任务开始时跳过 */
+    };
+
+    QCache<QString, QPixmap> cache;           /**< LRU 缓存，key 为 "来源@宽x高"，cost 单位 KB */
+    QHash<QString, Pending> inflight;         /**< 正在生成的任务 */
+    QThreadPool pool;                         /**< 缩略图生成线程池 */
+    int requestPriority = 0;                  /**< 递增的任务优先级，后请求的先执行 */
+    bool stopped = false;                     /**< 已调用 shutdown()，不再接受请求 */
+};
@@ -5,6 +5,7 @@
 #ifndef LAB2QRCODE_CONVERT_H
 #define LAB2QRCODE_CONVERT_H
 
+#include <cstddef>
 #include <variant>
 #include <vector>
 
@@ -82,11 +83,43 @@ struct QRcode_create_config {
     int margin = 1;
 };
 
-[[nodiscard]] inline QImage byte_to_QRCode_qimage(const std::string &text, const QRcode_create_config qrcode_config) {
+/**
+ * @brief 单个条码能容纳的最大字符数（最紧凑的数字模式、最低纠错等级），未知的格式返回 0
+ *
+ * 用于在读取文件之前快速判断输入是否必然无法编码为一个条码。读取前不知道内容的字符集，
+ * 纯数字的文本（包括 Base64 结果）可以比字节模式多容纳一倍以上，因此只能用数字模式的容量作为上限。
+ */
+[[nodiscard]] constexpr std::size_t max_payload_chars(ZXing::BarcodeFormat format) noexcept {
+    switch (format) {
+    case ZXing::BarcodeFormat::QRCode: return 7089;
+    case ZXing::BarcodeFormat::DataMatrix: return 3116;
+    case ZXing::BarcodeFormat::Aztec: return 3832;
+    case ZXing::BarcodeFormat::PDF417: return 2710;
+    default: return 0;
+    }
+}
+
+/**
+ * @brief 长度为 len 的数据经过（可选的）Base64 编码后的长度
+ */
+[[nodiscard]] constexpr std::size_t encoded_payload_size(std::size_t len, bool base64) noexcept {
+    return base64 ? (len + 2) / 3 * 4 : len;
+}
+
+/**
+ * @brief 将数据编码为条码位矩阵
+ */
+[[nodiscard]] inline ZXing::BitMatrix byte_to_BitMatrix(const std::string &text,
+                                                       const QRcode_create_config qrcode_config) {
     ZXing::MultiFormatWriter writer(qrcode_config.format);
     writer.setMargin(qrcode_config.margin);
+    return writer.encode(text, qrcode_config.target_width, qrcode_config.target_height);
+}
 
-    const auto bitMatrix = writer.encode(text, qrcode_config.target_width, qrcode_config.target_height);
+/**
+ * @brief 将条码位矩阵转为灰度图片
+ */
+[[nodiscard]] inline QImage BitMatrix_to_qimage(const ZXing::BitMatrix &bitMatrix) {
     const auto width = bitMatrix.width();
     const auto height = bitMatrix.height();
 
@@ -102,6 +135,10 @@ struct QRcode_create_config {
     return image;
 }
 
+[[nodiscard]] inline QImage byte_to_QRCode_qimage(const std::string &text, const QRcode_create_config qrcode_config) {
+    return BitMatrix_to_qimage(byte_to_BitMatrix(text, qrcode_config));
+}
+
 struct result_i2t { //image to text result, 傻瓜式expected
     enum errcode {
         success,
@@ -125,8 +162,7 @@ struct result_i2t { //image to text result, 傻瓜式expected
     }
 };
 
-[[nodiscard]] inline result_i2t QRcode_to_byte(const std::string &file_path) {
-    const cv::Mat img = cv::imread(file_path, cv::IMREAD_COLOR);
+[[nodiscard]] inline result_i2t QRcode_to_byte(const cv::Mat &img) {
     if (img.empty()) {
         return result_i2t::empty_img;
     }
@@ -144,6 +180,31 @@ struct result_i2t { //image to text result, 傻瓜式expected
     return result.text();
 }
 
+[[nodiscard]] inline result_i2t QRcode_to_byte(const std::string &file_path) {
+    return QRcode_to_byte(cv::imread(file_path, cv::IMREAD_COLOR));
+}
+
+/**
+ * @brief 将内存中的图片文件数据（PNG/JPG 等编码数据）解码为 BGR 图像，失败时为空
+ */
+[[nodiscard]] inline cv::Mat decode_image(const QByteArray &encoded) {
+    if (encoded.isEmpty()) {
+        return {};
+    }
+    const cv::Mat buf(1, static_cast<int>(encoded.size()), CV_8UC1, const_cast<char *>(encoded.constData()));
+    return cv::imdecode(buf, cv::IMREAD_COLOR);
+}
+
+/**
+ * @brief 从内存中的图片文件数据（PNG/JPG 等编码数据）识别条码
+ */
+[[nodiscard]] inline result_i2t QRcode_to_byte(const QByteArray &encoded) {
+    if (encoded.isEmpty()) {
+        return result_i2t::empty_img;
+    }
+    return QRcode_to_byte(decode_image(encoded));
+}
+
 } // namespace convert
 
 #endif //LAB2QRCODE_CONVERT_H
\ No newline at end of file